@@ -5,4 +5,4 @@ DIR_SRC=src
 mkdir -p $DIR_BIN
 
 CFLAGS="-std=c11 -O2 -g -pedantic -Wall -Wextra -Wpointer-arith -Wshadow -Wstrict-prototypes"
-gcc $CFLAGS $DIR_SRC/texttable.c $DIR_SRC/texttable_run.c -o $DIR_BIN/texttable
\ No newline at end of file
+gcc $CFLAGS $DIR_SRC/texttable.c $DIR_SRC/texttable_run.c -pthread -o $DIR_BIN/texttable
\ No newline at end of file
@@ -0,0 +1,10 @@
+#!/bin/bash
+# Building the benchmarks requires a GNU linker, the heap functions are wrapped to count the allocations
+set -x #echo on
+DIR_BIN=bin
+DIR_SRC=src
+mkdir -p $DIR_BIN
+
+CFLAGS="-std=c11 -O2 -g -pedantic -Wall -Wextra -Wpointer-arith -Wshadow -Wstrict-prototypes"
+LDFLAGS="-Wl,--wrap=malloc -Wl,--wrap=calloc -Wl,--wrap=realloc -Wl,--wrap=free"
+gcc $CFLAGS $DIR_SRC/texttable.c $DIR_SRC/texttable_bench.c $LDFLAGS -pthread -o $DIR_BIN/texttable_bench
@@ -17,7 +17,7 @@ rm texttable_test.gcda
 
 ## Build
 CFLAGS="-std=c11 -O2 -g -pedantic -Wall -Wextra -Wpointer-arith -Wshadow -Wstrict-prototypes --coverage -DUNIT_TESTING"
-LIBS="-lcmocka"
+LIBS="-lcmocka -pthread"
 gcc $CFLAGS $DIR_SRC/texttable.c $DIR_SRC/texttable_test.c $LIBS -o $DIR_BIN/texttable_test
 
 ## Run test cases
@@ -11,6 +11,8 @@
  *  1. Before a table can be filled, the @ref TextTableInit() function must be called for initialization.
  *  2. The table can be filled with entries using the @ref TextTableAdd() function.
  *     For each table entry this function is called. __Please note that memory is allocated for each table entry__.
+ *     If the table was initialized with @ref TextTableInitArena() instead, the entries are taken from large memory
+ *     chunks owned by the table, so only one allocation per chunk is done.
  *  3. For the output the function @ref TextTablePrint() is used. For each table row the registered callback function
  *     is called. @ref TextTablePrint() can be called as often as you like, the table designs (@ref TabStyle_e) can be changed,
  *     different callback functions can be used. Please note that only an __even__ number of entries added with
@@ -83,8 +85,24 @@
 #include <stdlib.h>
 #include <stdarg.h>
 #include <string.h>
+#include <math.h>
+#ifndef __STDC_NO_ATOMICS__
+#include <stdatomic.h>
+#endif
+#ifndef __STDC_NO_THREADS__
+#include <threads.h>
+#endif
 #include "texttable.h"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define TEXT_TABLE_SCAN_AVX2  ///< AVX2 text scanner, selected at runtime
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define TEXT_TABLE_SCAN_SSE2  ///< SSE2 text scanner
+#endif
+
 #ifdef UNIT_TESTING
 #include "texttable_test.h"
 #endif
@@ -95,525 +113,3790 @@
 static const char sAnsiSequenceEnd[] = {0x1B, '[', '0', 'm'};
 
 /**
- * @brief   Internal use
+ * @brief   Shortest reset of all attributes, used by @ref TEXT_TABLE_ANSI_MINIMAL
+ */
+static const char sAnsiReset[] = {0x1B, '[', 'm'};
+
+/**
+ * @brief   Two digits at a time lookup table for the integer conversion
+ */
+static const char sDigitPairs[] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+/**
+ * @brief   Exact powers of ten for the double conversion
+ */
+static const double sPow10[] =
+{
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15
+};
+
+/**
+ * @brief   Code points of display width 0: combining marks (Mn, Me), format characters (Cf, without the soft
+ *          hyphen) and the Hangul medial vowels and final consonants. Unicode 14.0, sorted ranges, unassigned
+ *          code points between two ranges are merged into them.
+ */
+static const uint32_t sZeroWidth[][2] =
+{
+  {0x0300, 0x036F}, {0x0483, 0x0489}, {0x0591, 0x05BD}, {0x05BF, 0x05BF}, {0x05C1, 0x05C2}, {0x05C4, 0x05C5},
+  {0x05C7, 0x05C7}, {0x0600, 0x0605}, {0x0610, 0x061A}, {0x061C, 0x061C}, {0x064B, 0x065F}, {0x0670, 0x0670},
+  {0x06D6, 0x06DD}, {0x06DF, 0x06E4}, {0x06E7, 0x06E8}, {0x06EA, 0x06ED}, {0x070F, 0x070F}, {0x0711, 0x0711},
+  {0x0730, 0x074A}, {0x07A6, 0x07B0}, {0x07EB, 0x07F3}, {0x07FD, 0x07FD}, {0x0816, 0x0819}, {0x081B, 0x0823},
+  {0x0825, 0x0827}, {0x0829, 0x082D}, {0x0859, 0x085B}, {0x0890, 0x089F}, {0x08CA, 0x0902}, {0x093A, 0x093A},
+  {0x093C, 0x093C}, {0x0941, 0x0948}, {0x094D, 0x094D}, {0x0951, 0x0957}, {0x0962, 0x0963}, {0x0981, 0x0981},
+  {0x09BC, 0x09BC}, {0x09C1, 0x09C4}, {0x09CD, 0x09CD}, {0x09E2, 0x09E3}, {0x09FE, 0x0A02}, {0x0A3C, 0x0A3C},
+  {0x0A41, 0x0A51}, {0x0A70, 0x0A71}, {0x0A75, 0x0A75}, {0x0A81, 0x0A82}, {0x0ABC, 0x0ABC}, {0x0AC1, 0x0AC8},
+  {0x0ACD, 0x0ACD}, {0x0AE2, 0x0AE3}, {0x0AFA, 0x0B01}, {0x0B3C, 0x0B3C}, {0x0B3F, 0x0B3F}, {0x0B41, 0x0B44},
+  {0x0B4D, 0x0B56}, {0x0B62, 0x0B63}, {0x0B82, 0x0B82}, {0x0BC0, 0x0BC0}, {0x0BCD, 0x0BCD}, {0x0C00, 0x0C00},
+  {0x0C04, 0x0C04}, {0x0C3C, 0x0C3C}, {0x0C3E, 0x0C40}, {0x0C46, 0x0C56}, {0x0C62, 0x0C63}, {0x0C81, 0x0C81},
+  {0x0CBC, 0x0CBC}, {0x0CBF, 0x0CBF}, {0x0CC6, 0x0CC6}, {0x0CCC, 0x0CCD}, {0x0CE2, 0x0CE3}, {0x0D00, 0x0D01},
+  {0x0D3B, 0x0D3C}, {0x0D41, 0x0D44}, {0x0D4D, 0x0D4D}, {0x0D62, 0x0D63}, {0x0D81, 0x0D81}, {0x0DCA, 0x0DCA},
+  {0x0DD2, 0x0DD6}, {0x0E31, 0x0E31}, {0x0E34, 0x0E3A}, {0x0E47, 0x0E4E}, {0x0EB1, 0x0EB1}, {0x0EB4, 0x0EBC},
+  {0x0EC8, 0x0ECD}, {0x0F18, 0x0F19}, {0x0F35, 0x0F35}, {0x0F37, 0x0F37}, {0x0F39, 0x0F39}, {0x0F71, 0x0F7E},
+  {0x0F80, 0x0F84}, {0x0F86, 0x0F87}, {0x0F8D, 0x0FBC}, {0x0FC6, 0x0FC6}, {0x102D, 0x1030}, {0x1032, 0x1037},
+  {0x1039, 0x103A}, {0x103D, 0x103E}, {0x1058, 0x1059}, {0x105E, 0x1060}, {0x1071, 0x1074}, {0x1082, 0x1082},
+  {0x1085, 0x1086}, {0x108D, 0x108D}, {0x109D, 0x109D}, {0x1160, 0x11FF}, {0x135D, 0x135F}, {0x1712, 0x1714},
+  {0x1732, 0x1733}, {0x1752, 0x1753}, {0x1772, 0x1773}, {0x17B4, 0x17B5}, {0x17B7, 0x17BD}, {0x17C6, 0x17C6},
+  {0x17C9, 0x17D3}, {0x17DD, 0x17DD}, {0x180B, 0x180F}, {0x1885, 0x1886}, {0x18A9, 0x18A9}, {0x1920, 0x1922},
+  {0x1927, 0x1928}, {0x1932, 0x1932}, {0x1939, 0x193B}, {0x1A17, 0x1A18}, {0x1A1B, 0x1A1B}, {0x1A56, 0x1A56},
+  {0x1A58, 0x1A60}, {0x1A62, 0x1A62}, {0x1A65, 0x1A6C}, {0x1A73, 0x1A7F}, {0x1AB0, 0x1B03}, {0x1B34, 0x1B34},
+  {0x1B36, 0x1B3A}, {0x1B3C, 0x1B3C}, {0x1B42, 0x1B42}, {0x1B6B, 0x1B73}, {0x1B80, 0x1B81}, {0x1BA2, 0x1BA5},
+  {0x1BA8, 0x1BA9}, {0x1BAB, 0x1BAD}, {0x1BE6, 0x1BE6}, {0x1BE8, 0x1BE9}, {0x1BED, 0x1BED}, {0x1BEF, 0x1BF1},
+  {0x1C2C, 0x1C33}, {0x1C36, 0x1C37}, {0x1CD0, 0x1CD2}, {0x1CD4, 0x1CE0}, {0x1CE2, 0x1CE8}, {0x1CED, 0x1CED},
+  {0x1CF4, 0x1CF4}, {0x1CF8, 0x1CF9}, {0x1DC0, 0x1DFF}, {0x200B, 0x200F}, {0x202A, 0x202E}, {0x2060, 0x206F},
+  {0x20D0, 0x20F0}, {0x2CEF, 0x2CF1}, {0x2D7F, 0x2D7F}, {0x2DE0, 0x2DFF}, {0x302A, 0x302D}, {0x3099, 0x309A},
+  {0xA66F, 0xA672}, {0xA674, 0xA67D}, {0xA69E, 0xA69F}, {0xA6F0, 0xA6F1}, {0xA802, 0xA802}, {0xA806, 0xA806},
+  {0xA80B, 0xA80B}, {0xA825, 0xA826}, {0xA82C, 0xA82C}, {0xA8C4, 0xA8C5}, {0xA8E0, 0xA8F1}, {0xA8FF, 0xA8FF},
+  {0xA926, 0xA92D}, {0xA947, 0xA951}, {0xA980, 0xA982}, {0xA9B3, 0xA9B3}, {0xA9B6, 0xA9B9}, {0xA9BC, 0xA9BD},
+  {0xA9E5, 0xA9E5}, {0xAA29, 0xAA2E}, {0xAA31, 0xAA32}, {0xAA35, 0xAA36}, {0xAA43, 0xAA43}, {0xAA4C, 0xAA4C},
+  {0xAA7C, 0xAA7C}, {0xAAB0, 0xAAB0}, {0xAAB2, 0xAAB4}, {0xAAB7, 0xAAB8}, {0xAABE, 0xAABF}, {0xAAC1, 0xAAC1},
+  {0xAAEC, 0xAAED}, {0xAAF6, 0xAAF6}, {0xABE5, 0xABE5}, {0xABE8, 0xABE8}, {0xABED, 0xABED}, {0xFB1E, 0xFB1E},
+  {0xFE00, 0xFE0F}, {0xFE20, 0xFE2F}, {0xFEFF, 0xFEFF}, {0xFFF9, 0xFFFB}, {0x101FD, 0x101FD}, {0x102E0, 0x102E0},
+  {0x10376, 0x1037A}, {0x10A01, 0x10A0F}, {0x10A38, 0x10A3F}, {0x10AE5, 0x10AE6}, {0x10D24, 0x10D27},
+  {0x10EAB, 0x10EAC}, {0x10F46, 0x10F50}, {0x10F82, 0x10F85}, {0x11001, 0x11001}, {0x11038, 0x11046},
+  {0x11070, 0x11070}, {0x11073, 0x11074}, {0x1107F, 0x11081}, {0x110B3, 0x110B6}, {0x110B9, 0x110BA},
+  {0x110BD, 0x110BD}, {0x110C2, 0x110CD}, {0x11100, 0x11102}, {0x11127, 0x1112B}, {0x1112D, 0x11134},
+  {0x11173, 0x11173}, {0x11180, 0x11181}, {0x111B6, 0x111BE}, {0x111C9, 0x111CC}, {0x111CF, 0x111CF},
+  {0x1122F, 0x11231}, {0x11234, 0x11234}, {0x11236, 0x11237}, {0x1123E, 0x1123E}, {0x112DF, 0x112DF},
+  {0x112E3, 0x112EA}, {0x11300, 0x11301}, {0x1133B, 0x1133C}, {0x11340, 0x11340}, {0x11366, 0x11374},
+  {0x11438, 0x1143F}, {0x11442, 0x11444}, {0x11446, 0x11446}, {0x1145E, 0x1145E}, {0x114B3, 0x114B8},
+  {0x114BA, 0x114BA}, {0x114BF, 0x114C0}, {0x114C2, 0x114C3}, {0x115B2, 0x115B5}, {0x115BC, 0x115BD},
+  {0x115BF, 0x115C0}, {0x115DC, 0x115DD}, {0x11633, 0x1163A}, {0x1163D, 0x1163D}, {0x1163F, 0x11640},
+  {0x116AB, 0x116AB}, {0x116AD, 0x116AD}, {0x116B0, 0x116B5}, {0x116B7, 0x116B7}, {0x1171D, 0x1171F},
+  {0x11722, 0x11725}, {0x11727, 0x1172B}, {0x1182F, 0x11837}, {0x11839, 0x1183A}, {0x1193B, 0x1193C},
+  {0x1193E, 0x1193E}, {0x11943, 0x11943}, {0x119D4, 0x119DB}, {0x119E0, 0x119E0}, {0x11A01, 0x11A0A},
+  {0x11A33, 0x11A38}, {0x11A3B, 0x11A3E}, {0x11A47, 0x11A47}, {0x11A51, 0x11A56}, {0x11A59, 0x11A5B},
+  {0x11A8A, 0x11A96}, {0x11A98, 0x11A99}, {0x11C30, 0x11C3D}, {0x11C3F, 0x11C3F}, {0x11C92, 0x11CA7},
+  {0x11CAA, 0x11CB0}, {0x11CB2, 0x11CB3}, {0x11CB5, 0x11CB6}, {0x11D31, 0x11D45}, {0x11D47, 0x11D47},
+  {0x11D90, 0x11D91}, {0x11D95, 0x11D95}, {0x11D97, 0x11D97}, {0x11EF3, 0x11EF4}, {0x13430, 0x13438},
+  {0x16AF0, 0x16AF4}, {0x16B30, 0x16B36}, {0x16F4F, 0x16F4F}, {0x16F8F, 0x16F92}, {0x16FE4, 0x16FE4},
+  {0x1BC9D, 0x1BC9E}, {0x1BCA0, 0x1CF46}, {0x1D167, 0x1D169}, {0x1D173, 0x1D182}, {0x1D185, 0x1D18B},
+  {0x1D1AA, 0x1D1AD}, {0x1D242, 0x1D244}, {0x1DA00, 0x1DA36}, {0x1DA3B, 0x1DA6C}, {0x1DA75, 0x1DA75},
+  {0x1DA84, 0x1DA84}, {0x1DA9B, 0x1DAAF}, {0x1E000, 0x1E02A}, {0x1E130, 0x1E136}, {0x1E2AE, 0x1E2AE},
+  {0x1E2EC, 0x1E2EF}, {0x1E8D0, 0x1E8D6}, {0x1E944, 0x1E94A}, {0xE0001, 0xE01EF}
+};
+/**
+ * @brief   Code points of display width 2: East Asian Wide (W) and Fullwidth (F). Unicode 14.0, sorted ranges,
+ *          unassigned code points between two ranges are merged into them, the planes 2 and 3 are wide.
+ */
+static const uint32_t sWide[][2] =
+{
+  {0x1100, 0x115F}, {0x231A, 0x231B}, {0x2329, 0x232A}, {0x23E9, 0x23EC}, {0x23F0, 0x23F0}, {0x23F3, 0x23F3},
+  {0x25FD, 0x25FE}, {0x2614, 0x2615}, {0x2648, 0x2653}, {0x267F, 0x267F}, {0x2693, 0x2693}, {0x26A1, 0x26A1},
+  {0x26AA, 0x26AB}, {0x26BD, 0x26BE}, {0x26C4, 0x26C5}, {0x26CE, 0x26CE}, {0x26D4, 0x26D4}, {0x26EA, 0x26EA},
+  {0x26F2, 0x26F3}, {0x26F5, 0x26F5}, {0x26FA, 0x26FA}, {0x26FD, 0x26FD}, {0x2705, 0x2705}, {0x270A, 0x270B},
+  {0x2728, 0x2728}, {0x274C, 0x274C}, {0x274E, 0x274E}, {0x2753, 0x2755}, {0x2757, 0x2757}, {0x2795, 0x2797},
+  {0x27B0, 0x27B0}, {0x27BF, 0x27BF}, {0x2B1B, 0x2B1C}, {0x2B50, 0x2B50}, {0x2B55, 0x2B55}, {0x2E80, 0x303E},
+  {0x3041, 0x3247}, {0x3250, 0x4DBF}, {0x4E00, 0xA4C6}, {0xA960, 0xA97C}, {0xAC00, 0xD7A3}, {0xF900, 0xFAD9},
+  {0xFE10, 0xFE19}, {0xFE30, 0xFE6B}, {0xFF01, 0xFF60}, {0xFFE0, 0xFFE6}, {0x16FE0, 0x1B2FB}, {0x1F004, 0x1F004},
+  {0x1F0CF, 0x1F0CF}, {0x1F18E, 0x1F18E}, {0x1F191, 0x1F19A}, {0x1F200, 0x1F320}, {0x1F32D, 0x1F335},
+  {0x1F337, 0x1F37C}, {0x1F37E, 0x1F393}, {0x1F3A0, 0x1F3CA}, {0x1F3CF, 0x1F3D3}, {0x1F3E0, 0x1F3F0},
+  {0x1F3F4, 0x1F3F4}, {0x1F3F8, 0x1F43E}, {0x1F440, 0x1F440}, {0x1F442, 0x1F4FC}, {0x1F4FF, 0x1F53D},
+  {0x1F54B, 0x1F54E}, {0x1F550, 0x1F567}, {0x1F57A, 0x1F57A}, {0x1F595, 0x1F596}, {0x1F5A4, 0x1F5A4},
+  {0x1F5FB, 0x1F64F}, {0x1F680, 0x1F6C5}, {0x1F6CC, 0x1F6CC}, {0x1F6D0, 0x1F6D2}, {0x1F6D5, 0x1F6DF},
+  {0x1F6EB, 0x1F6EC}, {0x1F6F4, 0x1F6FC}, {0x1F7E0, 0x1F7F0}, {0x1F90C, 0x1F93A}, {0x1F93C, 0x1F945},
+  {0x1F947, 0x1F9FF}, {0x1FA70, 0x1FAF6}, {0x20000, 0x3FFFD}
+};
+
+/**
+ * @brief   Internal use - display width of one column, kept in the cached layout of the table.
+ *          The bytes of the ANSI sequences are tracked per row, see @ref TextTableLayout_t::ansiMaxLen.
  */
 typedef struct
 {
   size_t rowMaxTextLen;
-  size_t ansiSeqMaxLen;
 }T_Column;
 
 /**
- * @brief         Initialize the table.
- * @retval true   success
- * @retval false  failed
- * @ingroup       group_InterfaceFunctions
+ * @brief   Number of width counters per declared column: text widths 0..@ref TEXT_TABLE_MAX_COLUMN_LEN
  */
-bool TextTableInit(TextTable_t *table) ///< [in] The table
+#define TEXT_TABLE_WIDTH_COUNTS (TEXT_TABLE_MAX_COLUMN_LEN + 1)
+
+/**
+ * @brief   ANSI bytes of one row of a fixed layout, the rows are not known in advance
+ */
+#define TEXT_TABLE_FIXED_ANSI_LEN(columns) \
+  ((columns) * ((TEXT_TABLE_MAX_ANSI_SEQ_LEN - 1) + sizeof(sAnsiSequenceEnd)))
+
+/**
+ * @brief   Multibyte character bytes beyond the display width of one row of a fixed layout, a cell row has at most
+ *          @ref TEXT_TABLE_MAX_COLUMN_LEN bytes
+ */
+#define TEXT_TABLE_FIXED_UTF8_LEN(columns) ((columns) * TEXT_TABLE_MAX_COLUMN_LEN)
+
+/**
+ * @name    Render flags of @ref TextTableRenderLines()
+ * @{
+ */
+#define TEXT_TABLE_RENDER_HEAD        0x01  ///< Render the header (first table row) in front of the rows
+#define TEXT_TABLE_RENDER_CONTINUE    0x02  ///< The rows continue a rendered table: no top line
+#define TEXT_TABLE_RENDER_SEPARATE    0x04  ///< With continue: the previous row was no header, separate it
+#define TEXT_TABLE_RENDER_OPEN        0x08  ///< More rows will follow: no bottom line
+/// @}
+
+/**
+ * @name    Style flags of @ref TextTableStyles_t
+ * @{
+ */
+#define TEXT_TABLE_STYLE_BLANK_VISIBLE  0x01  ///< The style changes the look of spaces, e.g. a background color
+#define TEXT_TABLE_STYLE_RESETS         0x02  ///< The sequence starts with a reset of all attributes
+/// @}
+
+_Static_assert(TEXT_TABLE_MAX_COLUMN_LEN <= UINT16_MAX, "text length is stored in uint16_t");
+_Static_assert(TEXT_TABLE_MAX_ANSI_SEQ_LEN <= UINT8_MAX, "ANSI sequence length is stored in uint8_t");
+_Static_assert(TEXT_TABLE_MAX_COLUMN_LEN < UINT8_MAX, "number of text rows is stored in uint8_t");
+
+static bool TextTableStreamRows(TextTable_t* table);
+
+/**
+ * @brief   Lock of the cached layout, so one table can be printed by several threads at once
+ */
+#ifndef __STDC_NO_ATOMICS__
+typedef atomic_flag TextTableLock_t;
+#else
+typedef bool TextTableLock_t; ///< No atomics: concurrent prints of one table are not supported
+#endif
+
+/**
+ * @brief   Counter shared by threads, see @ref TextTableSnapshotShared_t
+ */
+#ifndef __STDC_NO_ATOMICS__
+typedef atomic_size_t TextTableCounter_t;
+#else
+typedef size_t TextTableCounter_t; ///< No atomics: the snapshot tables cannot be shared by threads
+#endif
+
+/**
+ * @brief   Internal use - the part of a snapshot written by the writer and the readers at once
+ */
+struct TextTableSnapshotShared_t
 {
-  if (NULL != table)
-  {
-    table->head = NULL;
-    table->tail = NULL;
-    table->entries = 0;
-    table->charGridX = '-';
-    table->charGridBoundary = '|';
-    table->charGridSeparator = '|';
-    table->charHeadX = '=';
-    table->charHeadBoundary = '|';
-    table->charHeadSeparator = '|';
-    table->charConnectorXY = '+';
-    table->spacesBetweenBorder = 1;
-    return true;
-  }
-  else
-  {
-    return false;
-  }
+  TextTableCounter_t readers[TEXT_TABLE_SNAPSHOT_TABLES]; ///< Number of readers printing each table
+  TextTableCounter_t published;                           ///< Index of the published table, `TEXT_TABLE_SNAPSHOT_TABLES` = none
+};
+
+/**
+ * @brief   Internal use - the cached layout of a table and its lock. The table only points to the layout, so the
+ *          print functions update the cache without writing to the table, which may be defined `const`.
+ */
+typedef struct
+{
+  TextTableLayout_t layout;   ///< The cached layout, must be the first member: `table->layout` points to the cache
+  TextTableLock_t lock;       ///< Held while a print updates or copies the layout or an append claims or publishes rows
+  size_t appendEnd;           ///< End of the entries claimed by the appends in progress
+  size_t appendPending;       ///< Number of appends in progress: entries claimed, but not yet part of the table
+  size_t appendCopying;       ///< Number of appends copying their rows into the cell arrays without the lock
+}T_LayoutCache;
+
+/**
+ * @brief   The layout cache of a table.
+ */
+static T_LayoutCache* TextTableCache(const TextTable_t* table) ///< [in] The table
+{
+  return (T_LayoutCache*)table->layout;
 }
 
 /**
- * @brief   Add table entry.
- *          - For each entry memory is allocated (free with @ref TextTableFree())
- *          - `\n` adds new row in entry
- * @retval true   success - the entry will be added to the table
- * @retval false  failed - the entry will __not__ be added to the table
- * @ingroup group_InterfaceFunctions
+ * @brief   Take the lock of the cached layout, spins while another print or append holds it.
  */
-bool TextTableAdd(
-  TextTable_t* table,   ///< [in] The table
-  const char* ansiSeq,  ///< [in] ANSI-sequence string, closing tag will be added automatically
-  const char* format,   ///< [in] printf(...) like
-  ...)                  ///< [in] printf(...) like arguments
+static void TextTableLock(T_LayoutCache* pCache) ///< [in] The layout cache
 {
-  if (NULL == table)
+#ifndef __STDC_NO_ATOMICS__
+  while (atomic_flag_test_and_set_explicit(&pCache->lock, memory_order_acquire))
   {
-    return false;
+#ifndef __STDC_NO_THREADS__
+    thrd_yield(); // the holder may be preempted, e.g. more appending threads than cores
+#endif
   }
+#else
+  (void)pCache;
+#endif
+}
+
+/**
+ * @brief   Release the lock of the cached layout.
+ */
+static void TextTableUnlock(T_LayoutCache* pCache) ///< [in] The layout cache
+{
+#ifndef __STDC_NO_ATOMICS__
+  atomic_flag_clear_explicit(&pCache->lock, memory_order_release);
+#else
+  (void)pCache;
+#endif
+}
+
+/**
+ * @brief   Release the lock of the cached layout for a moment, so other threads can go on, and take it again.
+ */
+static void TextTableLockYield(T_LayoutCache* pCache) ///< [in] The layout cache
+{
+  TextTableUnlock(pCache);
+#ifndef __STDC_NO_THREADS__
+  thrd_yield();
+#endif
+  TextTableLock(pCache);
+}
 
-  TextTableEntry_t* pEntry = (TextTableEntry_t*)malloc(sizeof(TextTableEntry_t));
-  if (pEntry == NULL)
+/**
+ * @brief   Allocate the layout cache on the first change of the table.
+ *          A table without entries is not printed, so the const print functions always find the cache.
+ * @retval true   success
+ * @retval false  failed - no memory
+ */
+static bool TextTableCacheCreate(TextTable_t* table) ///< [in] The table
+{
+  if (NULL == table->layout)
   {
-    return false;
+    T_LayoutCache* pCache = (T_LayoutCache*)calloc(1, sizeof(T_LayoutCache));
+    if (NULL == pCache)
+    {
+      return false;
+    }
+    TextTableUnlock(pCache);
+    table->layout = &pCache->layout;
   }
+  return true;
+}
 
-  memset(pEntry, 0, sizeof(TextTableEntry_t));
+/**
+ * @brief   Size of the arena chunk header, keeps the usable memory of a chunk aligned
+ */
+#define TEXT_TABLE_CHUNK_HEADER_SIZE  ((sizeof(TextTableChunk_t) + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1))
 
-  if (NULL == table->head)
+/**
+ * @brief   Allocate table memory.
+ *          - Without arena the memory is allocated with `malloc()` and must be released with `free()`
+ *          - With arena the memory is taken from the current chunk, a new chunk is allocated if it is exhausted
+ * @return  Pointer to the memory or NULL
+ */
+static void* TextTableAlloc(
+  TextTable_t* table, ///< [in] The table
+  size_t size,        ///< [in] Number of bytes
+  size_t align)       ///< [in] Alignment of the memory, must be a power of two
+{
+  if (0 == table->chunkSize)
   {
-    // no entry in table
-    table->head = pEntry;
-    pEntry->prevEntry = NULL;
+    return malloc(size);
   }
-  else
+
+  TextTableChunk_t* pChunk = table->chunks;
+  size_t offset = 0;
+  if (NULL != pChunk)
   {
-    table->tail->nextEntry = pEntry;
-    pEntry->prevEntry = table->tail;
-    table->tail->nextEntry = pEntry;
+    offset = (pChunk->used + (align - 1)) & ~(align - 1);
   }
-  table->tail = pEntry;
-  table->entries++;
-
-  // calculate length for column buffer
-  if (NULL != format)
+  if ((NULL == pChunk) || ((offset + size) > pChunk->size))
   {
-    va_list arg;
-    va_start(arg, format);
-    int textLen = vsnprintf(NULL, 0, format, arg);
-    va_end(arg);
-
-    if (textLen > 0)
+    size_t chunkSize = (size > table->chunkSize) ? size : table->chunkSize;
+    pChunk = (TextTableChunk_t*)malloc(TEXT_TABLE_CHUNK_HEADER_SIZE + chunkSize);
+    if (NULL == pChunk)
     {
-      pEntry->textLen = textLen;
-      if (ansiSeq != NULL)
-      {
-        pEntry->ansiSeqLen = strlen(ansiSeq);
-        if (TEXT_TABLE_MAX_ANSI_SEQ_LEN > pEntry->ansiSeqLen)
-        {
-          pEntry->ansiSeq = (char*)malloc(pEntry->ansiSeqLen + 1);
-          snprintf(pEntry->ansiSeq, pEntry->ansiSeqLen + 1, "%s", ansiSeq);
-        }
-        else
-        {
-          pEntry->ansiSeqLen = 0;
-        }
-      }
-
-      if (TEXT_TABLE_MAX_COLUMN_LEN < pEntry->textLen)
-      {
-        pEntry->textLen = TEXT_TABLE_MAX_COLUMN_LEN;
-      }
-      pEntry->text = (char*)malloc(pEntry->textLen + 1);
-      if (pEntry->text == NULL)
-      {
-        pEntry->textLen = 0;
-        return false;
-      }
-      memset(pEntry->text, 0, pEntry->textLen + 1);
-
-      va_start(arg, format);
-      if (vsnprintf(pEntry->text, pEntry->textLen + 1, format, arg) < 1)
-      {
-        memset(pEntry->text, 0, pEntry->textLen + 1);
-      }
-      va_end(arg);
-
-      // calculate the maximum length column row
-      pEntry->rowMaxTextLen = 1;
-      size_t rowTextLen = 0;
-      for (size_t i = 0; i < pEntry->textLen; i++)
-      {
-        if ('\n' == pEntry->text[i])
-        {
-          if (pEntry->rowMaxTextLen < rowTextLen)
-          {
-            pEntry->rowMaxTextLen = rowTextLen;
-          }
-          rowTextLen = 0;
-        }
-        else
-        {
-          rowTextLen++;
-        }
-      }
-      if (pEntry->rowMaxTextLen < rowTextLen)
-      {
-        pEntry->rowMaxTextLen = rowTextLen;
-      }
+      return NULL;
     }
+    pChunk->size = chunkSize;
+    pChunk->nextChunk = table->chunks;
+    table->chunks = pChunk;
+    offset = 0;
   }
-  return true;
+  pChunk->used = offset + size;
+  return (char*)pChunk + TEXT_TABLE_CHUNK_HEADER_SIZE + offset;
 }
 
 /**
- * @brief         Print the table line by line to the registered output-callback-function.
+ * @brief   Resize one cell array.
  * @retval true   success
- * @retval false  failed
- * @ingroup       group_InterfaceFunctions
+ * @retval false  failed - the array is unchanged
  */
-bool TextTablePrint(
-  TextTable_t* table,                                 ///< [in] The table.
-  void(*PrintLineCallbackFunction)(const char* line), ///< [in] Function pointer to output function.
-  TabStyle_e tabStyle,                                ///< [in] Choose one of the styles.
-  size_t posX,                                        ///< [in] Number of chars to right shift the table.
-  size_t columns)                                     ///< [in] Number of table columns.
-                                                      /// Please note that only an __even__ number of entries added with
-                                                      /// @ref TextTableAdd() will work. Otherwise the rows cannot calculated.
+static bool TextTableResizeArray(
+  void* array,        ///< [in,out] Pointer to the array pointer
+  size_t elements,    ///< [in] New number of elements
+  size_t elementSize) ///< [in] Size of one element
 {
-  if (NULL == table)
+  void** pArray = (void**)array;
+  void* pNew = realloc(*pArray, elements * elementSize);
+  if (NULL == pNew)
   {
     return false;
   }
-  if (NULL == PrintLineCallbackFunction)
+  *pArray = pNew;
+  return true;
+}
+
+/**
+ * @brief   Make sure a buffer of the render context or the layout can hold `elements` elements.
+ *          The buffer only grows (high-water mark), so steady-state rendering does not allocate.
+ * @retval true   success
+ * @retval false  failed - no memory, the buffer is unchanged
+ */
+static bool TextTableCtxReserve(
+  void* buf,          ///< [in,out] Pointer to the buffer pointer
+  size_t* capacity,   ///< [in,out] Number of elements the buffer can hold
+  size_t elements,    ///< [in] Required number of elements
+  size_t elementSize) ///< [in] Size of one element
+{
+  if (elements <= *capacity)
   {
-    return false;
+    return true;
   }
-  if (posX > TEXT_TABLE_MAX_X_POS)
+  if (!TextTableResizeArray(buf, elements, elementSize))
   {
     return false;
   }
-  if (columns == 0)
+  *capacity = elements;
+  return true;
+}
+
+/**
+ * @brief   Make sure the cell arrays can hold at least `cells` cells, the capacity grows by doubling.
+ * @retval true   success
+ * @retval false  failed
+ */
+static bool TextTableReserve(
+  TextTable_t* table, ///< [in] The table
+  size_t cells)       ///< [in] Number of cells
+{
+  TextTableCells_t* pCells = &table->cells;
+  if (cells <= pCells->capacity)
   {
-    return false;
+    return true;
   }
-  if (table->entries == 0)
+  if (!TextTableCacheCreate(table))
   {
     return false;
   }
 
-  // calculate number of rows in the table
-  size_t rows = table->entries / columns;
-  if (table->entries != (rows * columns))
+  size_t capacity = (0 == pCells->capacity) ? 64 : pCells->capacity;
+  while (capacity < cells)
   {
-    return false;   // cannot calculate rows
+    capacity *= 2;
   }
-
-  T_Column* pColumn = (T_Column*)malloc(sizeof(T_Column) * columns);
-  if (pColumn == NULL)
+  if (!TextTableResizeArray(&pCells->text, capacity, sizeof(*pCells->text)) ||
+      !TextTableResizeArray(&pCells->textLen, capacity, sizeof(*pCells->textLen)) ||
+      !TextTableResizeArray(&pCells->textCap, capacity, sizeof(*pCells->textCap)) ||
+      !TextTableResizeArray(&pCells->rowMaxTextLen, capacity, sizeof(*pCells->rowMaxTextLen)) ||
+      !TextTableResizeArray(&pCells->styleId, capacity, sizeof(*pCells->styleId)) ||
+      !TextTableResizeArray(&pCells->ansiSeqLen, capacity, sizeof(*pCells->ansiSeqLen)) ||
+      !TextTableResizeArray(&pCells->flags, capacity, sizeof(*pCells->flags)) ||
+      !TextTableResizeArray(&pCells->textRows, capacity, sizeof(*pCells->textRows)) ||
+      ((NULL != pCells->rowStart) && !TextTableResizeArray(&pCells->rowStart, capacity, sizeof(*pCells->rowStart))))
   {
     return false;
   }
-  // calculate max text length (width) of each column row in the table
-  memset(pColumn, 0, sizeof(T_Column) * columns);
-  TextTableEntry_t* pEntry = table->head;
-  for (size_t i = 0; i < rows; i++)
-  {
-    for (size_t j = 0; j < columns; j++)
-    {
-      if (pEntry->rowMaxTextLen > pColumn[j].rowMaxTextLen)
-      {
-        pColumn[j].rowMaxTextLen = pEntry->rowMaxTextLen;
-      }
-      if (pEntry->ansiSeqLen > pColumn[j].ansiSeqMaxLen)
-      {
-        pColumn[j].ansiSeqMaxLen = pEntry->ansiSeqLen;
-      }
-      pEntry = pEntry->nextEntry;
-    }
-  }
-  // calculate row length
-  size_t rowLen = 2; // + 1 '\0' zero terminated string, + 1 opening column character
-  for (size_t i = 0; i < columns; i++)
-  {
-    rowLen += pColumn[i].rowMaxTextLen + (table->spacesBetweenBorder * 2) + 1; // +1 closing column character
-    if (pColumn[i].ansiSeqMaxLen)
-    {
-      rowLen += pColumn[i].ansiSeqMaxLen + sizeof(sAnsiSequenceEnd);
-    }
-  }
-  rowLen = rowLen + posX;
+  pCells->capacity = capacity;
+  return true;
+}
 
-  char* rowBuf = (char*)malloc(rowLen);
-  if (rowBuf == NULL)
+/**
+ * @brief         Initialize the table.
+ * @retval true   success
+ * @retval false  failed
+ * @ingroup       group_InterfaceFunctions
+ */
+bool TextTableInit(TextTable_t *table) ///< [in] The table
+{
+  if (NULL != table)
   {
-    return false;
+    memset(&table->cells, 0, sizeof(table->cells));
+    memset(&table->styles, 0, sizeof(table->styles));
+    table->layout = NULL;
+    table->entries = 0;
+    table->chunks = NULL;
+    table->chunkSize = 0;
+    table->columns = 0;
+    table->stream = NULL;
+    table->charGridX = '-';
+    table->charGridBoundary = '|';
+    table->charGridSeparator = '|';
+    table->charHeadX = '=';
+    table->charHeadBoundary = '|';
+    table->charHeadSeparator = '|';
+    table->charConnectorXY = '+';
+    table->spacesBetweenBorder = 1;
+    table->ansiMode = TEXT_TABLE_ANSI_FULL;
+    return true;
   }
   else
   {
-    memset(rowBuf, ' ', rowLen);
+    return false;
   }
+}
 
-  char* gridBuf = (char*)malloc(rowLen);
-  if (gridBuf == NULL)
+/**
+ * @brief         Initialize the table with an arena.
+ *                All entries and texts are taken from memory chunks of `chunkSize` bytes
+ *                owned by the table, @ref TextTableFree() releases the whole chunks at once.
+ * @retval true   success
+ * @retval false  failed
+ * @ingroup       group_InterfaceFunctions
+ */
+bool TextTableInitArena(
+  TextTable_t *table, ///< [in] The table
+  size_t chunkSize)   ///< [in] Size of one arena chunk in bytes, 0 = @ref TEXT_TABLE_ARENA_CHUNK_SIZE
+{
+  if (!TextTableInit(table))
   {
     return false;
   }
-  else
+  table->chunkSize = (0 == chunkSize) ? TEXT_TABLE_ARENA_CHUNK_SIZE : chunkSize;
+  return true;
+}
+
+/**
+ * @brief         Declare the number of table columns.
+ *                Must be called after @ref TextTableInit() or @ref TextTableInitArena() and before the first
+ *                entry is added. Each added entry then updates the width of its column, so the print does not
+ *                need to measure the table and `columns` 0 can be passed to the print functions.
+ *                The table can only be printed with the declared number of columns, cells can be changed
+ *                with @ref TextTableSet().
+ * @retval true   success
+ * @retval false  failed - invalid arguments, entries already added or no memory
+ * @ingroup       group_InterfaceFunctions
+ */
+bool TextTableInitColumns(
+  TextTable_t *table, ///< [in] The table
+  size_t columns)     ///< [in] Number of table columns
+{
+  if ((NULL == table) || (0 == columns) || (0 != table->entries) || !TextTableCacheCreate(table))
   {
-    memset(gridBuf, ' ', rowLen);
+    return false;
   }
-
-  char* headBuf = (char*)malloc(rowLen);
-  if (headBuf == NULL)
+  TextTableLayout_t* pLayout = table->layout;
+  if (!TextTableCtxReserve(&pLayout->columns, &pLayout->columnsCap, columns, sizeof(T_Column)))
   {
     return false;
   }
-  else
+  size_t* pWidthCount = (size_t*)calloc(columns * TEXT_TABLE_WIDTH_COUNTS, sizeof(size_t));
+  if (NULL == pWidthCount)
   {
-    memset(headBuf, ' ', rowLen);
+    return false;
   }
+  free(pLayout->widthCount);
+  pLayout->widthCount = pWidthCount;
+  memset(pLayout->columns, 0, sizeof(T_Column) * columns);
+  pLayout->columnCount = columns;
+  pLayout->entries = 0;
+  pLayout->ansiMaxLen = 0;
+  pLayout->ansiRowLen = 0;
+  pLayout->utf8MaxLen = 0;
+  pLayout->utf8RowLen = 0;
+  pLayout->gridLen = 0;
+  table->columns = columns;
+  return true;
+}
 
-  // create border / header
-  size_t idx = posX;
-  gridBuf[idx] = table->charConnectorXY;
-  headBuf[idx] = table->charConnectorXY;
-  idx++;
-  for (size_t i = 0; i < columns; i++)
-  {
-    for (size_t j = 0; j < (pColumn[i].rowMaxTextLen + (table->spacesBetweenBorder * 2)); j++)
+/**
+ * @brief   Find a code point in sorted ranges.
+ */
+static bool TextTableInRanges(
+  uint32_t code,                  ///< [in] The code point
+  const uint32_t (*pRanges)[2],   ///< [in] Sorted ranges, first and last code point
+  size_t count)                   ///< [in] Number of ranges
+{
+  size_t low = 0;
+  size_t high = count;
+  while (low < high)
+  {
+    size_t mid = (low + high) / 2;
+    if (code > pRanges[mid][1])
+    {
+      low = mid + 1;
+    }
+    else if (code < pRanges[mid][0])
+    {
+      high = mid;
+    }
+    else
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief   Display width of a code point on a terminal.
+ * @return  0 (combining), 1 or 2 (East Asian wide) columns
+ */
+static size_t TextTableCodeWidth(uint32_t code) ///< [in] The code point
+{
+  if (code < 0x0300) // Latin, no table entries in front of the combining diacritical marks
+  {
+    return 1;
+  }
+  if (TextTableInRanges(code, sZeroWidth, sizeof(sZeroWidth) / sizeof(sZeroWidth[0])))
+  {
+    return 0;
+  }
+  return TextTableInRanges(code, sWide, sizeof(sWide) / sizeof(sWide[0])) ? 2 : 1;
+}
+
+/**
+ * @brief   Decode one UTF-8 character. An invalid or incomplete sequence is one character of one byte,
+ *          it is printed as it is and counts one column like a replacement character.
+ *          Overlong encodings, UTF-16 surrogates and code points above U+10FFFF are invalid.
+ * @return  Number of bytes of the character, at least 1
+ */
+static size_t TextTableUtf8Decode(
+  const char* text,   ///< [in] The character
+  size_t len,         ///< [in] Bytes left in the text, at least 1
+  uint32_t* pCode)    ///< [out] The code point
+{
+  const uint8_t* pText = (const uint8_t*)text;
+  size_t n = (pText[0] >= 0xF0) ? 4 : ((pText[0] >= 0xE0) ? 3 : 2);
+  *pCode = 0xFFFD;
+  if ((pText[0] < 0xC0) || (pText[0] >= 0xF8) || (n > len))
+  {
+    *pCode = (pText[0] < 0x80) ? pText[0] : 0xFFFD;
+    return 1;
+  }
+  uint32_t code = pText[0] & (0x7Fu >> n);
+  for (size_t i = 1; i < n; i++)
+  {
+    if (0x80 != (pText[i] & 0xC0))
+    {
+      return 1;
+    }
+    code = (code << 6) | (pText[i] & 0x3Fu);
+  }
+  static const uint32_t sMinCode[] = {0, 0, 0x80, 0x800, 0x10000};
+  if ((code < sMinCode[n]) || ((code >= 0xD800) && (code <= 0xDFFF)) || (code > 0x10FFFF))
+  {
+    return 1;
+  }
+  *pCode = code;
+  return n;
+}
+
+/**
+ * @brief   Fit a text row into `maxWidth` columns: the longest beginning of the row that fits, including the
+ *          zero width characters behind it. Runs of ASCII characters skip the decoding and the width tables,
+ *          with SSE2 16 bytes at a time.
+ * @return  Number of bytes that fit
+ */
+static size_t TextTableTextFit(
+  const char* text,   ///< [in] The text row
+  size_t len,         ///< [in] Length of the text row
+  size_t maxWidth,    ///< [in] Available columns, `SIZE_MAX` = measure the whole row
+  size_t* pWidth)     ///< [out] Display width of the bytes that fit
+{
+  size_t width = 0;
+  size_t pos = 0;
+  while (pos < len)
+  {
+#ifdef TEXT_TABLE_SCAN_SSE2
+    if (((len - pos) >= 16) && ((maxWidth - width) >= 16) &&
+        (0 == _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)&text[pos]))))
+    {
+      pos += 16;
+      width += 16;
+      continue;
+    }
+#endif
+    if (0 == ((uint8_t)text[pos] & 0x80))
+    {
+      if (width == maxWidth)
+      {
+        break;
+      }
+      pos++;
+      width++;
+      continue;
+    }
+    uint32_t code = 0;
+    size_t n = TextTableUtf8Decode(&text[pos], len - pos, &code);
+    size_t codeWidth = TextTableCodeWidth(code);
+    if (codeWidth > (maxWidth - width))
+    {
+      break;
+    }
+    pos += n;
+    width += codeWidth;
+  }
+  *pWidth = width;
+  return pos;
+}
+
+/**
+ * @brief   Shorten a text that was cut after `len` bytes to whole UTF-8 characters.
+ * @return  The length without an incomplete character at the end
+ */
+static size_t TextTableUtf8Cut(
+  const char* text, ///< [in] The text
+  size_t len)       ///< [in] Length of the cut text
+{
+  for (size_t back = 1; (back <= 4) && (back <= len); back++)
+  {
+    uint8_t c = (uint8_t)text[len - back];
+    if (0x80 != (c & 0xC0)) // first byte of the last character
+    {
+      size_t n = (c >= 0xF0) ? 4 : ((c >= 0xE0) ? 3 : ((c >= 0xC0) ? 2 : 1));
+      return (n > back) ? (len - back) : len;
+    }
+  }
+  return len;
+}
+
+/**
+ * @brief   Internal use - result of the text scan, see @ref TextTableScanText()
+ */
+typedef struct
+{
+  size_t rowMaxTextLen;   ///< Maximum display width of the printed rows (separated by `\n`, up to the first `\0`), at least 1
+  size_t textRows;        ///< Number of printed rows, a `\0` in the text ends the output
+  bool utf8;              ///< The text has multibyte characters, the display width is not the byte length
+  size_t textEnd;         ///< Position of the first `\0` in the text, the text length if there is none
+  size_t rowPos;          ///< Position of the current row
+  uint8_t rowStart[TEXT_TABLE_MAX_COLUMN_LEN + 2]; ///< Start of each printed row, followed by `textEnd + 1`
+}T_TextScan;
+
+/**
+ * @brief   Start the scan of a text.
+ */
+static void TextTableScanInit(
+  T_TextScan* pScan,  ///< [out] The scan result
+  size_t textLen)     ///< [in] Length of the text
+{
+  pScan->rowMaxTextLen = 1;
+  pScan->textRows = 1;
+  pScan->utf8 = false;
+  pScan->textEnd = textLen;
+  pScan->rowPos = 0;
+  pScan->rowStart[0] = 0;
+}
+
+/**
+ * @brief   Position of the lowest set bit.
+ * @return  The bit position, `mask` must not be 0
+ */
+static size_t TextTableLowestBit(
+  uint32_t mask)  ///< [in] The bit mask
+{
+#ifdef __GNUC__
+  return (size_t)__builtin_ctz(mask);
+#else
+  size_t bit = 0;
+  while (0 == (mask & ((uint32_t)1 << bit)))
+  {
+    bit++;
+  }
+  return bit;
+#endif
+}
+
+/**
+ * @brief   Include the `\n` and `\0` positions of one block of up to 32 bytes into the scan.
+ */
+static void TextTableScanMasks(
+  T_TextScan* pScan,    ///< [in,out] The scan result
+  size_t blockPos,      ///< [in] Position of the block in the text
+  uint32_t newLines,    ///< [in] Bit mask of the `\n` in the block
+  uint32_t textEnds)    ///< [in] Bit mask of the `\0` in the block
+{
+  if ((0 != textEnds) && ((blockPos + TextTableLowestBit(textEnds)) < pScan->textEnd))
+  {
+    pScan->textEnd = blockPos + TextTableLowestBit(textEnds);
+  }
+  for (; 0 != newLines; newLines &= newLines - 1)
+  {
+    size_t pos = blockPos + TextTableLowestBit(newLines);
+    if (pos > pScan->textEnd)
+    {
+      break; // rows behind the `\0` are not printed and not measured
+    }
+    if ((pos - pScan->rowPos) > pScan->rowMaxTextLen)
+    {
+      pScan->rowMaxTextLen = pos - pScan->rowPos;
+    }
+    pScan->rowPos = pos + 1;
+    pScan->rowStart[pScan->textRows] = (uint8_t)(pos + 1);
+    pScan->textRows++;
+  }
+}
+
+/**
+ * @brief   Finish the scan of a text, includes the last printed row up to the end of the output.
+ */
+static void TextTableScanDone(T_TextScan* pScan) ///< [in,out] The scan result
+{
+  if ((pScan->textEnd - pScan->rowPos) > pScan->rowMaxTextLen)
+  {
+    pScan->rowMaxTextLen = pScan->textEnd - pScan->rowPos;
+  }
+  pScan->rowStart[pScan->textRows] = (uint8_t)(pScan->textEnd + 1);
+}
+
+/**
+ * @brief   Scan a text byte by byte, see @ref TextTableScanText().
+ */
+static void TextTableScanTextScalar(
+  const char* text,   ///< [in] The text
+  size_t textLen,     ///< [in] Length of the text
+  T_TextScan* pScan)  ///< [out] The scan result
+{
+  uint8_t highBits = 0;
+  TextTableScanInit(pScan, textLen);
+  for (size_t i = 0; i < textLen; i++)
+  {
+    highBits |= (uint8_t)text[i];
+    if (('\n' == text[i]) || (0x00 == text[i]))
+    {
+      TextTableScanMasks(pScan, i, ('\n' == text[i]) ? 1 : 0, (0x00 == text[i]) ? 1 : 0);
+    }
+  }
+  pScan->utf8 = (0 != (highBits & 0x80));
+  TextTableScanDone(pScan);
+}
+
+#ifdef TEXT_TABLE_SCAN_SSE2
+/**
+ * @brief   Scan a text 16 bytes at a time, see @ref TextTableScanText().
+ *          The last block is copied, so no byte behind the text is read.
+ */
+static void TextTableScanTextSse2(
+  const char* text,   ///< [in] The text
+  size_t textLen,     ///< [in] Length of the text
+  T_TextScan* pScan)  ///< [out] The scan result
+{
+  const __m128i newLine = _mm_set1_epi8('\n');
+  const __m128i zero = _mm_setzero_si128();
+  char tail[16];
+  uint32_t highBits = 0;
+  TextTableScanInit(pScan, textLen);
+  for (size_t i = 0; i < textLen; i += 16)
+  {
+    const char* pBlock = &text[i];
+    if ((textLen - i) < 16)
+    {
+      memset(tail, ' ', sizeof(tail));
+      memcpy(tail, pBlock, textLen - i);
+      pBlock = tail;
+    }
+    __m128i block = _mm_loadu_si128((const __m128i*)pBlock);
+    highBits |= (uint32_t)_mm_movemask_epi8(block);
+    uint32_t newLines = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, newLine));
+    uint32_t textEnds = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, zero));
+    if (0 != (newLines | textEnds))
+    {
+      TextTableScanMasks(pScan, i, newLines, textEnds);
+    }
+  }
+  pScan->utf8 = (0 != highBits);
+  TextTableScanDone(pScan);
+}
+#endif
+
+#ifdef TEXT_TABLE_SCAN_AVX2
+/**
+ * @brief   Scan a text 32 bytes at a time, see @ref TextTableScanText().
+ *          The last block is copied, so no byte behind the text is read.
+ */
+__attribute__((target("avx2")))
+static void TextTableScanTextAvx2(
+  const char* text,   ///< [in] The text
+  size_t textLen,     ///< [in] Length of the text
+  T_TextScan* pScan)  ///< [out] The scan result
+{
+  const __m256i newLine = _mm256_set1_epi8('\n');
+  const __m256i zero = _mm256_setzero_si256();
+  char tail[32];
+  uint32_t highBits = 0;
+  TextTableScanInit(pScan, textLen);
+  for (size_t i = 0; i < textLen; i += 32)
+  {
+    const char* pBlock = &text[i];
+    if ((textLen - i) < 32)
+    {
+      memset(tail, ' ', sizeof(tail));
+      memcpy(tail, pBlock, textLen - i);
+      pBlock = tail;
+    }
+    __m256i block = _mm256_loadu_si256((const __m256i*)pBlock);
+    highBits |= (uint32_t)_mm256_movemask_epi8(block);
+    uint32_t newLines = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newLine));
+    uint32_t textEnds = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, zero));
+    if (0 != (newLines | textEnds))
+    {
+      TextTableScanMasks(pScan, i, newLines, textEnds);
+    }
+  }
+  pScan->utf8 = (0 != highBits);
+  TextTableScanDone(pScan);
+}
+#endif
+
+/**
+ * @brief   Scan a text in one pass for the row separators `\n` and the end of the output `\0`:
+ *          the maximum row width, the number of printed rows and where each of them starts.
+ *          Longer texts are scanned with the widest instruction set of the CPU (AVX2, SSE2, byte by byte).
+ *          The scan also finds out if the text is pure ASCII, only other texts are measured character by
+ *          character for their display width.
+ */
+static void TextTableScanText(
+  const char* text,   ///< [in] The text
+  size_t textLen,     ///< [in] Length of the text
+  T_TextScan* pScan)  ///< [out] The scan result
+{
+  if (textLen < 16) // most cells, a single block is not worth the copy
+  {
+    TextTableScanTextScalar(text, textLen, pScan);
+  }
+#ifdef TEXT_TABLE_SCAN_AVX2
+  else if (__builtin_cpu_supports("avx2"))
+  {
+    TextTableScanTextAvx2(text, textLen, pScan);
+  }
+#endif
+  else
+  {
+#ifdef TEXT_TABLE_SCAN_SSE2
+    TextTableScanTextSse2(text, textLen, pScan);
+#else
+    TextTableScanTextScalar(text, textLen, pScan);
+#endif
+  }
+
+  // multibyte characters: the width of the printed rows instead of their length
+  if (pScan->utf8)
+  {
+    pScan->rowMaxTextLen = 1;
+    for (size_t row = 0; row < pScan->textRows; row++)
+    {
+      size_t width = 0;
+      TextTableTextFit(&text[pScan->rowStart[row]], pScan->rowStart[row + 1] - 1 - pScan->rowStart[row], SIZE_MAX,
+                       &width);
+      pScan->rowMaxTextLen = (width > pScan->rowMaxTextLen) ? width : pScan->rowMaxTextLen;
+    }
+  }
+}
+
+/**
+ * @brief   Bytes of the ANSI sequence and the closing tag of one cell in each of its lines.
+ */
+static size_t TextTableCellAnsiLen(
+  const TextTableCells_t* pCells, ///< [in] The cells
+  size_t cell)                    ///< [in] Index of the cell
+{
+  return (0 == pCells->styleId[cell]) ? 0 : (pCells->ansiSeqLen[cell] + sizeof(sAnsiSequenceEnd));
+}
+
+/**
+ * @brief   Bytes of the multibyte characters of one cell beyond their display width, in each of its lines.
+ *          The bytes of a row minus its width is at most the length of the text minus the widest row.
+ */
+static size_t TextTableCellUtf8Len(
+  const TextTableCells_t* pCells, ///< [in] The cells
+  size_t cell)                    ///< [in] Index of the cell
+{
+  if ((0 == (pCells->flags[cell] & TEXT_TABLE_CELL_UTF8)) || (pCells->textLen[cell] <= pCells->rowMaxTextLen[cell]))
+  {
+    return 0;
+  }
+  return (size_t)pCells->textLen[cell] - pCells->rowMaxTextLen[cell];
+}
+
+/**
+ * @brief   Add the bytes of a measured cell beyond its display width to its row,
+ *          the row buffer fits the row with the most of these bytes.
+ */
+static void TextTableLayoutRow(
+  TextTableLayout_t* pLayout, ///< [in] The layout
+  size_t column,              ///< [in] Column of the cell
+  size_t ansiLen,             ///< [in] ANSI bytes of the cell, see @ref TextTableCellAnsiLen()
+  size_t utf8Len)             ///< [in] Multibyte character bytes of the cell, see @ref TextTableCellUtf8Len()
+{
+  pLayout->ansiRowLen = ((0 == column) ? 0 : pLayout->ansiRowLen) + ansiLen;
+  pLayout->utf8RowLen = ((0 == column) ? 0 : pLayout->utf8RowLen) + utf8Len;
+  if (pLayout->ansiRowLen > pLayout->ansiMaxLen)
+  {
+    pLayout->ansiMaxLen = pLayout->ansiRowLen;
+    pLayout->gridLen = 0;
+  }
+  if (pLayout->utf8RowLen > pLayout->utf8MaxLen)
+  {
+    pLayout->utf8MaxLen = pLayout->utf8RowLen;
+    pLayout->gridLen = 0;
+  }
+}
+
+/**
+ * @brief   Include a new entry into the column widths of the layout,
+ *          as long as the layout is up to date (declared columns or printed before).
+ */
+static void TextTableLayoutAdd(
+  TextTable_t* table, ///< [in] The table
+  size_t idx)         ///< [in] Index of the new entry
+{
+  TextTableLayout_t* pLayout = table->layout;
+  if ((0 == pLayout->columnCount) || (pLayout->entries != idx) || pLayout->fixed)
+  {
+    return;
+  }
+  size_t column = idx % pLayout->columnCount;
+  T_Column* pColumn = &((T_Column*)pLayout->columns)[column];
+  if (NULL != pLayout->widthCount)
+  {
+    size_t* pWidthCount = &pLayout->widthCount[column * TEXT_TABLE_WIDTH_COUNTS];
+    pWidthCount[table->cells.rowMaxTextLen[idx]]++;
+  }
+  if (table->cells.rowMaxTextLen[idx] > pColumn->rowMaxTextLen)
+  {
+    pColumn->rowMaxTextLen = table->cells.rowMaxTextLen[idx];
+    pLayout->gridLen = 0;
+  }
+  TextTableLayoutRow(pLayout, column, TextTableCellAnsiLen(&table->cells, idx),
+                     TextTableCellUtf8Len(&table->cells, idx));
+  pLayout->entries = idx + 1;
+}
+
+/**
+ * @brief   Row index of a cell.
+ * @return  The start of each row of the text, NULL if the whole text is printed in one row
+ */
+static const uint8_t* TextTableRowStart(
+  const TextTableCells_t* pCells, ///< [in] The cells
+  size_t idx)                     ///< [in] Index of the cell
+{
+  return (NULL == pCells->rowStart) ? NULL : pCells->rowStart[idx];
+}
+
+/**
+ * @brief   Store the row starts of a scanned text in table memory,
+ *          a text printed in one row needs no row index.
+ *          The index array of the cells is created with the first text that needs an index.
+ * @retval true   success
+ * @retval false  failed - no memory
+ */
+static bool TextTableRowIndex(
+  TextTable_t* table,       ///< [in] The table
+  const T_TextScan* pScan,  ///< [in] The scanned text
+  size_t textLen,           ///< [in] Length of the text
+  uint8_t** ppRowStart)     ///< [out] The row index or NULL
+{
+  TextTableCells_t* pCells = &table->cells;
+  *ppRowStart = NULL;
+  if ((1 == pScan->textRows) && (textLen == pScan->textEnd))
+  {
+    return true;
+  }
+  if (NULL == pCells->rowStart)
+  {
+    if (!TextTableResizeArray(&pCells->rowStart, pCells->capacity, sizeof(*pCells->rowStart)))
+    {
+      return false;
+    }
+    memset(pCells->rowStart, 0, pCells->capacity * sizeof(*pCells->rowStart));
+  }
+  *ppRowStart = (uint8_t*)TextTableAlloc(table, pScan->textRows + 1, 1);
+  if (NULL == *ppRowStart)
+  {
+    return false;
+  }
+  memcpy(*ppRowStart, pScan->rowStart, pScan->textRows + 1);
+  return true;
+}
+
+/**
+ * @brief   Sequence of a style, see @ref TextTableStyles_t.
+ */
+static const char* TextTableStyleSeq(
+  const TextTableStyles_t* pStyles, ///< [in] The style table
+  size_t styleId)                   ///< [in] The style id, not 0
+{
+  return &pStyles->seq[(styleId - 1) * TEXT_TABLE_MAX_ANSI_SEQ_LEN];
+}
+
+/**
+ * @brief   Classify an ANSI sequence for @ref TEXT_TABLE_ANSI_MINIMAL.
+ *          Only SGR sequences (`ESC [ params m`) are understood, any other sequence counts as visible on spaces.
+ *          Of the SGR attributes only underline, inverse, strike-through, overline and background colors
+ *          change the look of spaces; foreground colors, bold, italic and blink do not.
+ * @return  The style flags, e.g. @ref TEXT_TABLE_STYLE_BLANK_VISIBLE
+ */
+static uint8_t TextTableStyleFlags(
+  const char* ansiSeq,  ///< [in] The ANSI sequence
+  size_t ansiSeqLen)    ///< [in] Length of the sequence
+{
+  if ((ansiSeqLen < 3) || (0x1B != ansiSeq[0]) || ('[' != ansiSeq[1]) || ('m' != ansiSeq[ansiSeqLen - 1]))
+  {
+    return TEXT_TABLE_STYLE_BLANK_VISIBLE;
+  }
+
+  // parameters, an empty parameter is 0
+  unsigned params[TEXT_TABLE_MAX_ANSI_SEQ_LEN];
+  size_t count = 0;
+  params[0] = 0;
+  for (size_t i = 2; i < (ansiSeqLen - 1); i++)
+  {
+    if (';' == ansiSeq[i])
+    {
+      params[++count] = 0;
+    }
+    else if ((ansiSeq[i] >= '0') && (ansiSeq[i] <= '9') && (params[count] < 1000))
+    {
+      params[count] = (params[count] * 10) + (unsigned)(ansiSeq[i] - '0');
+    }
+    else
+    {
+      return TEXT_TABLE_STYLE_BLANK_VISIBLE; // sub-parameters, private sequences ...
+    }
+  }
+  count++;
+
+  uint8_t flags = (0 == params[0]) ? TEXT_TABLE_STYLE_RESETS : 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    unsigned value = params[i];
+    if (0 == value)
+    {
+      flags &= (uint8_t)~TEXT_TABLE_STYLE_BLANK_VISIBLE;
+    }
+    else if (38 == value)
+    {
+      // extended foreground color `38;5;n` or `38;2;r;g;b`
+      i += ((i + 1) < count) && (2 == params[i + 1]) ? 4 : 2;
+    }
+    else if ((value <= 3) || (5 == value) || (6 == value) || (8 == value) || ((value >= 10) && (value <= 20)) ||
+             ((value >= 22) && (value <= 39)) || (49 == value) || (50 == value) ||
+             ((value >= 54) && (value <= 57)) || (59 == value) || ((value >= 90) && (value <= 97)))
+    {
+      // intensity, italic, blink, fonts, foreground colors and the attribute resets: spaces look the same
+    }
+    else
+    {
+      flags |= TEXT_TABLE_STYLE_BLANK_VISIBLE; // underline, inverse, strike-through, background colors, unknown
+    }
+  }
+  return flags;
+}
+
+/**
+ * @brief   Find an ANSI sequence in the style table or add it, tables use only a few different sequences.
+ * @return  The style id, 0 = no memory or too many styles
+ */
+static uint8_t TextTableStyleIntern(
+  TextTableStyles_t* pStyles, ///< [in] The style table
+  const char* ansiSeq,        ///< [in] The ANSI sequence
+  size_t ansiSeqLen)          ///< [in] Length of the sequence, less than @ref TEXT_TABLE_MAX_ANSI_SEQ_LEN
+{
+  for (size_t i = 0; i < pStyles->count; i++)
+  {
+    if ((pStyles->seqLen[i] == ansiSeqLen) &&
+        (0 == memcmp(&pStyles->seq[i * TEXT_TABLE_MAX_ANSI_SEQ_LEN], ansiSeq, ansiSeqLen)))
+    {
+      return (uint8_t)(i + 1);
+    }
+  }
+  if (TEXT_TABLE_MAX_STYLES == pStyles->count)
+  {
+    return 0;
+  }
+  if (pStyles->count == pStyles->capacity)
+  {
+    size_t capacity = (0 == pStyles->capacity) ? 8 : (pStyles->capacity * 2);
+    capacity = (capacity > TEXT_TABLE_MAX_STYLES) ? TEXT_TABLE_MAX_STYLES : capacity;
+    if (!TextTableResizeArray(&pStyles->seq, capacity, TEXT_TABLE_MAX_ANSI_SEQ_LEN) ||
+        !TextTableResizeArray(&pStyles->seqLen, capacity, sizeof(*pStyles->seqLen)) ||
+        !TextTableResizeArray(&pStyles->flags, capacity, sizeof(*pStyles->flags)))
+    {
+      return 0;
+    }
+    pStyles->capacity = capacity;
+  }
+  memcpy(&pStyles->seq[pStyles->count * TEXT_TABLE_MAX_ANSI_SEQ_LEN], ansiSeq, ansiSeqLen);
+  pStyles->seqLen[pStyles->count] = (uint8_t)ansiSeqLen;
+  pStyles->flags[pStyles->count] = TextTableStyleFlags(ansiSeq, ansiSeqLen);
+  pStyles->count++;
+  return (uint8_t)pStyles->count;
+}
+
+/**
+ * @brief   Append one cell to the table.
+ *          - The text is copied, with @ref TEXT_TABLE_CELL_BORROWED only the pointer is stored
+ *          - Texts longer than @ref TEXT_TABLE_MAX_COLUMN_LEN are truncated
+ *          - The ANSI sequence is only stored for a non-empty text, as id of the style table
+ * @retval true   success
+ * @retval false  failed - no free style id or no memory for the style, the cell is not added;
+ *                no memory for the text, the cell is added as empty cell
+ */
+static bool TextTableStoreCell(
+  TextTable_t* table,   ///< [in] The table
+  const char* ansiSeq,  ///< [in] ANSI-sequence string or NULL
+  const char* text,     ///< [in] The text, must not be zero terminated
+  size_t textLen,       ///< [in] Length of the text, 0 = empty cell
+  uint8_t flags)        ///< [in] Cell flags
+{
+  uint8_t styleId = 0;
+  size_t ansiSeqLen = ((0 == textLen) || (NULL == ansiSeq)) ? 0 : strlen(ansiSeq);
+  if (TEXT_TABLE_MAX_ANSI_SEQ_LEN <= ansiSeqLen)
+  {
+    ansiSeqLen = 0;
+  }
+  if (0 != ansiSeqLen)
+  {
+    styleId = TextTableStyleIntern(&table->styles, ansiSeq, ansiSeqLen);
+    if (0 == styleId)
+    {
+      return false;
+    }
+  }
+  if (!TextTableReserve(table, table->entries + 1))
+  {
+    return false;
+  }
+
+  TextTableCells_t* pCells = &table->cells;
+  size_t idx = table->entries;
+  pCells->text[idx] = NULL;
+  pCells->textLen[idx] = 0;
+  pCells->textCap[idx] = 0;
+  pCells->rowMaxTextLen[idx] = 0;
+  pCells->styleId[idx] = 0;
+  pCells->ansiSeqLen[idx] = 0;
+  pCells->flags[idx] = 0;
+  pCells->textRows[idx] = 1;
+  if (NULL != pCells->rowStart)
+  {
+    pCells->rowStart[idx] = NULL;
+  }
+  table->entries++;
+
+  if (0 == textLen)
+  {
+    TextTableLayoutAdd(table, idx);
+    return true;
+  }
+
+  pCells->styleId[idx] = styleId;
+  pCells->ansiSeqLen[idx] = (uint8_t)ansiSeqLen;
+
+  if (TEXT_TABLE_MAX_COLUMN_LEN < textLen)
+  {
+    textLen = TextTableUtf8Cut(text, TEXT_TABLE_MAX_COLUMN_LEN);
+  }
+
+  // calculate the maximum width column row and where the rows start
+  T_TextScan scan;
+  uint8_t* pRowStart = NULL;
+  TextTableScanText(text, textLen, &scan);
+  if (!TextTableRowIndex(table, &scan, textLen, &pRowStart))
+  {
+    TextTableLayoutAdd(table, idx);
+    return false;
+  }
+  if (0 == (flags & TEXT_TABLE_CELL_BORROWED))
+  {
+    char* pText = (char*)TextTableAlloc(table, textLen + 1, 1);
+    if (pText == NULL)
+    {
+      if (0 == table->chunkSize)
+      {
+        free(pRowStart);
+      }
+      TextTableLayoutAdd(table, idx);
+      return false;
+    }
+    memcpy(pText, text, textLen);
+    pText[textLen] = 0x00;
+    text = pText;
+    pCells->textCap[idx] = (uint16_t)textLen;
+  }
+  pCells->text[idx] = text;
+  pCells->textLen[idx] = (uint16_t)textLen;
+  pCells->flags[idx] = scan.utf8 ? (uint8_t)(flags | TEXT_TABLE_CELL_UTF8) : flags;
+  pCells->rowMaxTextLen[idx] = (uint16_t)scan.rowMaxTextLen;
+  pCells->textRows[idx] = (uint8_t)scan.textRows;
+  if (NULL != pCells->rowStart)
+  {
+    pCells->rowStart[idx] = pRowStart;
+  }
+  TextTableLayoutAdd(table, idx);
+  return true;
+}
+
+/**
+ * @brief   Append one cell to the table (see @ref TextTableStoreCell()), a streamed table prints each completed row.
+ * @retval true   success
+ * @retval false  failed - no memory for the text or the row could not be printed
+ */
+static bool TextTableAddCell(
+  TextTable_t* table,   ///< [in] The table
+  const char* ansiSeq,  ///< [in] ANSI-sequence string or NULL
+  const char* text,     ///< [in] The text, must not be zero terminated
+  size_t textLen,       ///< [in] Length of the text, 0 = empty cell
+  uint8_t flags)        ///< [in] Cell flags
+{
+  size_t entries = table->entries;
+  bool ok = TextTableStoreCell(table, ansiSeq, text, textLen, flags);
+  if ((NULL != table->stream) && (entries != table->entries) && (0 == (table->entries % table->columns)))
+  {
+    ok = TextTableStreamRows(table) && ok;
+  }
+  return ok;
+}
+
+/**
+ * @brief   Convert an unsigned integer to decimal digits, two digits at a time.
+ * @return  Number of written chars (not zero terminated), at most 20
+ */
+static size_t TextTableFormatUInt(
+  char* buf,      ///< [out] Buffer of at least 20 chars
+  uint64_t value) ///< [in] The value
+{
+  char digits[20];
+  size_t pos = sizeof(digits);
+  while (value >= 100)
+  {
+    const char* pPair = &sDigitPairs[(value % 100) * 2];
+    value /= 100;
+    digits[--pos] = pPair[1];
+    digits[--pos] = pPair[0];
+  }
+  if (value >= 10)
+  {
+    digits[--pos] = sDigitPairs[(value * 2) + 1];
+    digits[--pos] = sDigitPairs[value * 2];
+  }
+  else
+  {
+    digits[--pos] = (char)('0' + value);
+  }
+  memcpy(buf, &digits[pos], sizeof(digits) - pos);
+  return sizeof(digits) - pos;
+}
+
+/**
+ * @brief   Convert a signed integer to decimal digits.
+ * @return  Number of written chars (not zero terminated), at most 20
+ */
+static size_t TextTableFormatInt(
+  char* buf,      ///< [out] Buffer of at least 20 chars
+  int64_t value)  ///< [in] The value
+{
+  if (value < 0)
+  {
+    buf[0] = '-';
+    return 1 + TextTableFormatUInt(&buf[1], (uint64_t)0 - (uint64_t)value);
+  }
+  return TextTableFormatUInt(buf, (uint64_t)value);
+}
+
+/**
+ * @brief   Write the scaled integer `mantissa * 10^-decimals` as decimal fraction, e.g. 31415 and 4 gives "3.1415".
+ * @return  Number of written chars (not zero terminated), at most 37
+ */
+static size_t TextTableFormatFixed(
+  char* buf,          ///< [out] Buffer of at least 37 chars
+  bool negative,      ///< [in] Write a minus sign
+  uint64_t mantissa,  ///< [in] The scaled value, less than 2^53
+  size_t decimals)    ///< [in] Number of decimals, at most 15
+{
+  size_t len = 0;
+  if (negative)
+  {
+    buf[len++] = '-';
+  }
+  uint64_t scale = (uint64_t)sPow10[decimals];
+  len += TextTableFormatUInt(&buf[len], mantissa / scale);
+  if (0 < decimals)
+  {
+    char fraction[20];
+    size_t fractionLen = TextTableFormatUInt(fraction, mantissa % scale);
+    buf[len++] = '.';
+    memset(&buf[len], '0', decimals - fractionLen);
+    memcpy(&buf[len + (decimals - fractionLen)], fraction, fractionLen);
+    len += decimals;
+  }
+  return len;
+}
+
+/**
+ * @brief   Convert a double to text.
+ *          - `precision` >= 0: same result as `printf("%.*f")`, values with up to 9 decimals and an integer part
+ *            below 2^40 are converted with a scaled integer, all other values with `snprintf()`
+ *          - `precision` < 0: shortest text that converts back to the same double, without exponent for values
+ *            that are exact with up to 15 decimals, otherwise the shortest `printf("%.*g")` representation
+ * @return  Length of the text, can be greater than the buffer (truncated like `snprintf()`)
+ */
+static size_t TextTableFormatDouble(
+  char* buf,        ///< [out] Buffer, will be zero terminated
+  size_t bufSize,   ///< [in] Size of the buffer, at least 38 chars
+  double value,     ///< [in] The value
+  int precision)    ///< [in] Number of decimals or < 0 for shortest round-trip
+{
+  size_t len = 0;
+  if (isfinite(value))
+  {
+    bool negative = signbit(value);
+    double absValue = negative ? -value : value;
+    if (0 <= precision)
+    {
+      if (9 >= precision)
+      {
+        double scaled = absValue * sPow10[precision];
+        if (scaled < 1099511627776.0) // 2^40, the rounding error stays far below the 0.5 decision
+        {
+          uint64_t mantissa = (uint64_t)scaled;
+          double remainder = scaled - (double)mantissa;
+          if ((remainder < 0.499) || (remainder > 0.501))
+          {
+            if (remainder > 0.5)
+            {
+              mantissa++;
+            }
+            len = TextTableFormatFixed(buf, negative, mantissa, (size_t)precision);
+          }
+        }
+      }
+    }
+    else
+    {
+      for (size_t decimals = 0; decimals < (sizeof(sPow10) / sizeof(sPow10[0])); decimals++)
+      {
+        double scaled = absValue * sPow10[decimals];
+        if (scaled >= 9007199254740992.0) // 2^53, no longer exact
+        {
+          break;
+        }
+        uint64_t mantissa = (uint64_t)(scaled + 0.5);
+        if (((double)mantissa / sPow10[decimals]) == absValue)
+        {
+          len = TextTableFormatFixed(buf, negative, mantissa, decimals);
+          break;
+        }
+      }
+    }
+  }
+  if (0 < len)
+  {
+    buf[len] = 0x00;
+    return len;
+  }
+
+  // fallback
+  int formatLen = 0;
+  if (0 <= precision)
+  {
+    formatLen = snprintf(buf, bufSize, "%.*f", precision, value);
+  }
+  else
+  {
+    for (int digits = 1; digits <= 17; digits++)
+    {
+      formatLen = snprintf(buf, bufSize, "%.*g", digits, value);
+      if (!isfinite(value) || (strtod(buf, NULL) == value))
+      {
+        break;
+      }
+    }
+  }
+  return (formatLen < 0) ? 0 : (size_t)formatLen;
+}
+
+/**
+ * @brief   Add table entry.
+ *          - For each entry memory is allocated (free with @ref TextTableFree())
+ *          - `\n` adds new row in entry
+ *          - The text is formatted only once into a buffer of @ref TEXT_TABLE_MAX_COLUMN_LEN,
+ *            longer texts are truncated anyway
+ * @retval true   success - the entry will be added to the table
+ * @retval false  failed - the entry will __not__ be added to the table
+ * @ingroup group_InterfaceFunctions
+ */
+bool TextTableAdd(
+  TextTable_t* table,   ///< [in] The table
+  const char* ansiSeq,  ///< [in] ANSI-sequence string, closing tag will be added automatically
+  const char* format,   ///< [in] printf(...) like
+  ...)                  ///< [in] printf(...) like arguments
+{
+  if (NULL == table)
+  {
+    return false;
+  }
+
+  char text[TEXT_TABLE_MAX_COLUMN_LEN + 1];
+  int textLen = 0;
+  if (NULL != format)
+  {
+    va_list arg;
+    va_start(arg, format);
+    textLen = vsnprintf(text, sizeof(text), format, arg);
+    va_end(arg);
+  }
+  if (textLen < 0)
+  {
+    textLen = 0;
+  }
+  return TextTableAddCell(table, ansiSeq, text, (size_t)textLen, 0);
+}
+
+/**
+ * @brief   Add table entry with a signed integer, same text as `printf("%" PRId64)` without format parsing.
+ * @retval true   success - the entry will be added to the table
+ * @retval false  failed - the entry will __not__ be added to the table
+ * @ingroup group_InterfaceFunctions
+ */
+bool TextTableAddInt(
+  TextTable_t* table,   ///< [in] The table
+  const char* ansiSeq,  ///< [in] ANSI-sequence string, closing tag will be added automatically
+  int64_t value)        ///< [in] The value
+{
+  if (NULL == table)
+  {
+    return false;
+  }
+  char text[24];
+  return TextTableAddCell(table, ansiSeq, text, TextTableFormatInt(text, value), 0);
+}
+
+/**
+ * @brief   Add table entry with an unsigned integer, same text as `printf("%" PRIu64)` without format parsing.
+ * @retval true   success - the entry will be added to the table
+ * @retval false  failed - the entry will __not__ be added to the table
+ * @ingroup group_InterfaceFunctions
+ */
+bool TextTableAddUInt(
+  TextTable_t* table,   ///< [in] The table
+  const char* ansiSeq,  ///< [in] ANSI-sequence string, closing tag will be added automatically
+  uint64_t value)       ///< [in] The value
+{
+  if (NULL == table)
+  {
+    return false;
+  }
+  char text[24];
+  return TextTableAddCell(table, ansiSeq, text, TextTableFormatUInt(text, value), 0);
+}
+
+/**
+ * @brief   Add table entry with a double.
+ *          - `precision` >= 0: same text as `printf("%.*f", precision, value)`
+ *          - `precision` < 0: shortest text that converts back to exactly the same value, e.g. "0.1" or "1e+300"
+ * @retval true   success - the entry will be added to the table
+ * @retval false  failed - the entry will __not__ be added to the table
+ * @ingroup group_InterfaceFunctions
+ */
+bool TextTableAddDouble(
+  TextTable_t* table,   ///< [in] The table
+  const char* ansiSeq,  ///< [in] ANSI-sequence string, closing tag will be added automatically
+  double value,         ///< [in] The value
+  int precision)        ///< [in] Number of decimals, < 0 = shortest round-trip representation
+{
+  if (NULL == table)
+  {
+    return false;
+  }
+  char text[TEXT_TABLE_MAX_COLUMN_LEN + 40];
+  return TextTableAddCell(table, ansiSeq, text, TextTableFormatDouble(text, sizeof(text), value, precision), 0);
+}
+
+/**
+ * @brief   Add table entry with a string of known length, the string is copied without format parsing.
+ *          - `\n` adds new row in entry
+ * @retval true   success - the entry will be added to the table
+ * @retval false  failed - the entry will __not__ be added to the table
+ * @ingroup group_InterfaceFunctions
+ */
+bool TextTableAddStr(
+  TextTable_t* table,   ///< [in] The table
+  const char* ansiSeq,  ///< [in] ANSI-sequence string, closing tag will be added automatically
+  const char* text,     ///< [in] The text, must not be zero terminated, NULL adds an empty entry
+  size_t textLen)       ///< [in] Length of the text
+{
+  if (NULL == table)
+  {
+    return false;
+  }
+  return TextTableAddCell(table, ansiSeq, text, (NULL == text) ? 0 : textLen, 0);
+}
+
+/**
+ * @brief   Add table entry that refers to a string owned by the caller (zero-copy).
+ *          - Only the pointer and the length are stored, the text is not copied
+ *          - The text must stay valid and unchanged until @ref TextTableFree() is called
+ *          - `\n` adds new row in entry
+ * @retval true   success - the entry will be added to the table
+ * @retval false  failed - the entry will __not__ be added to the table
+ * @ingroup group_InterfaceFunctions
+ */
+bool TextTableAddRef(
+  TextTable_t* table,   ///< [in] The table
+  const char* ansiSeq,  ///< [in] ANSI-sequence string, closing tag will be added automatically
+  const char* text,     ///< [in] The text, must not be zero terminated, NULL adds an empty entry
+  size_t textLen)       ///< [in] Length of the text
+{
+  if (NULL == table)
+  {
+    return false;
+  }
+  return TextTableAddCell(table, ansiSeq, text, (NULL == text) ? 0 : textLen, TEXT_TABLE_CELL_BORROWED);
+}
+
+/**
+ * @brief   Reset the column widths of a layout after its entries were taken away.
+ */
+static void TextTableLayoutReset(TextTableLayout_t* pLayout) ///< [in] The layout
+{
+  if (NULL != pLayout->columns)
+  {
+    memset(pLayout->columns, 0, sizeof(T_Column) * pLayout->columnCount);
+  }
+  if (NULL != pLayout->widthCount)
+  {
+    memset(pLayout->widthCount, 0, sizeof(size_t) * pLayout->columnCount * TEXT_TABLE_WIDTH_COUNTS);
+  }
+  pLayout->entries = 0;
+  pLayout->ansiMaxLen = 0;
+  pLayout->ansiRowLen = 0;
+  pLayout->utf8MaxLen = 0;
+  pLayout->utf8RowLen = 0;
+  pLayout->gridLen = 0;
+}
+
+/**
+ * @brief   Make the layout of a table count the widths of all its entries, as with declared columns.
+ *          The arrays are kept, so a table filled again and again is measured without allocation.
+ * @retval true   success
+ * @retval false  failed - no memory
+ */
+static bool TextTableLayoutCount(
+  TextTable_t* table, ///< [in] The table
+  size_t columns)     ///< [in] Number of table columns
+{
+  TextTableLayout_t* pLayout = table->layout;
+  if ((pLayout->columnCount != columns) || (NULL == pLayout->widthCount) || pLayout->fixed)
+  {
+    if (!TextTableCtxReserve(&pLayout->columns, &pLayout->columnsCap, columns, sizeof(T_Column)))
+    {
+      return false;
+    }
+    size_t* pWidthCount = (size_t*)calloc(columns * TEXT_TABLE_WIDTH_COUNTS, sizeof(size_t));
+    if (NULL == pWidthCount)
+    {
+      return false;
+    }
+    free(pLayout->widthCount);
+    pLayout->widthCount = pWidthCount;
+    pLayout->columnCount = columns;
+    pLayout->fixed = false;
+    TextTableLayoutReset(pLayout);
+  }
+  for (size_t idx = pLayout->entries; idx < table->entries; idx++)
+  {
+    TextTableLayoutAdd(table, idx);
+  }
+  return true;
+}
+
+/**
+ * @brief   Merge the counted widths of appended rows into the layout of the table,
+ *          as long as the layout is up to date. The cost depends on the columns, not on the number of cells.
+ */
+static void TextTableLayoutMerge(
+  TextTableLayout_t* pLayout,     ///< [in,out] Layout of the table
+  const TextTableLayout_t* pRows, ///< [in] Counted layout of the rows, see @ref TextTableLayoutCount()
+  size_t first,                   ///< [in] Index of the first appended entry
+  size_t count)                   ///< [in] Number of appended entries
+{
+  if ((pLayout->columnCount != pRows->columnCount) || (pLayout->entries != first) || pLayout->fixed)
+  {
+    return;
+  }
+  T_Column* pColumn = (T_Column*)pLayout->columns;
+  const T_Column* pRowsColumn = (const T_Column*)pRows->columns;
+  for (size_t column = 0; column < pLayout->columnCount; column++)
+  {
+    if (NULL != pLayout->widthCount)
+    {
+      size_t* pWidthCount = &pLayout->widthCount[column * TEXT_TABLE_WIDTH_COUNTS];
+      const size_t* pRowsWidthCount = &pRows->widthCount[column * TEXT_TABLE_WIDTH_COUNTS];
+      for (size_t width = 0; width <= pRowsColumn[column].rowMaxTextLen; width++)
+      {
+        pWidthCount[width] += pRowsWidthCount[width];
+      }
+    }
+    if (pRowsColumn[column].rowMaxTextLen > pColumn[column].rowMaxTextLen)
+    {
+      pColumn[column].rowMaxTextLen = pRowsColumn[column].rowMaxTextLen;
+      pLayout->gridLen = 0;
+    }
+  }
+  if (pRows->ansiMaxLen > pLayout->ansiMaxLen)
+  {
+    pLayout->ansiMaxLen = pRows->ansiMaxLen;
+    pLayout->gridLen = 0;
+  }
+  if (pRows->utf8MaxLen > pLayout->utf8MaxLen)
+  {
+    pLayout->utf8MaxLen = pRows->utf8MaxLen;
+    pLayout->gridLen = 0;
+  }
+  pLayout->ansiRowLen = pRows->ansiRowLen;
+  pLayout->utf8RowLen = pRows->utf8RowLen;
+  pLayout->entries = first + count;
+}
+
+/**
+ * @brief   Move complete rows from a table filled by one thread to the end of a shared table.
+ *          Several threads can append to one table at once: each thread fills its own `rows` table
+ *          (formatting, scanning and copying the texts need no lock) and moves the rows in one step.
+ *          - The lock of the shared table is only held to claim the entries `[first, first + count)`, with
+ *            growing the cell arrays and mapping the styles, and to publish them. The cells are copied
+ *            into the claimed entries without the lock, the cell arrays only grow while no append copies.
+ *          - The column widths of the rows are counted by the appending thread (declared columns of `rows`
+ *            count them while adding) and merged per column when the rows are published
+ *          - The rows are published in the order of their claims, the rows of one call are never interleaved
+ *            with the rows of another thread
+ *          - The texts are handed over: without arena the pointers, with arena the whole chunks
+ *          - `rows` is empty afterwards and keeps its arrays, so it can be filled again without allocation
+ *
+ *          The table must have declared columns (see @ref TextTableInitColumns()), both tables must either use
+ *          an arena or not. While any thread appends, no thread may print, change or add to the table:
+ *          growing the cell arrays may move them.
+ * @retval true   success
+ * @retval false  failed - invalid arguments, incomplete rows or no memory. The cells and styles of both tables
+ *                are unchanged, the cell arrays of the table may have grown.
+ * @ingroup group_InterfaceFunctions
+ */
+bool TextTableAppend(
+  TextTable_t* table, ///< [in] The shared table
+  TextTable_t* rows)  ///< [in,out] The rows to move, entries must be a multiple of the table columns
+{
+  if ((NULL == table) || (NULL == rows) || (table == rows) || (0 == table->columns) ||
+      (NULL != table->stream) || (NULL != rows->stream) ||
+      ((0 == table->chunkSize) != (0 == rows->chunkSize)) ||
+      ((0 != rows->columns) && (rows->columns != table->columns)) ||
+      (0 != (rows->entries % table->columns)))
+  {
+    return false;
+  }
+  size_t count = rows->entries;
+  if (0 == count)
+  {
+    return true;
+  }
+  if (!TextTableLayoutCount(rows, table->columns))
+  {
+    return false;
+  }
+
+  // claim the entries, the cell arrays are only changed while no other append copies into them
+  const TextTableCells_t* pSrc = &rows->cells;
+  TextTableCells_t* pCells = &table->cells;
+  T_LayoutCache* pCache = TextTableCache(table);
+  TextTableLock(pCache);
+  size_t first = (0 == pCache->appendPending) ? table->entries : pCache->appendEnd;
+  while (((first + count) > pCells->capacity) || ((NULL != pSrc->rowStart) && (NULL == pCells->rowStart)))
+  {
+    if (0 == pCache->appendCopying)
+    {
+      bool ok = TextTableReserve(table, first + count);
+      if (ok && (NULL != pSrc->rowStart) && (NULL == pCells->rowStart))
+      {
+        ok = TextTableResizeArray(&pCells->rowStart, pCells->capacity, sizeof(*pCells->rowStart));
+        if (ok)
+        {
+          memset(pCells->rowStart, 0, first * sizeof(*pCells->rowStart));
+        }
+      }
+      if (!ok)
+      {
+        TextTableUnlock(pCache);
+        return false;
+      }
+      break;
+    }
+    TextTableLockYield(pCache);
+    first = (0 == pCache->appendPending) ? table->entries : pCache->appendEnd;
+  }
+
+  // the style ids of the rows refer to their own style table
+  uint8_t styleMap[TEXT_TABLE_MAX_STYLES + 1];
+  size_t styles = table->styles.count;
+  styleMap[0] = 0;
+  for (size_t i = 0; i < rows->styles.count; i++)
+  {
+    styleMap[i + 1] = TextTableStyleIntern(&table->styles, TextTableStyleSeq(&rows->styles, i + 1),
+                                           rows->styles.seqLen[i]);
+    if (0 == styleMap[i + 1])
+    {
+      table->styles.count = styles;
+      TextTableUnlock(pCache);
+      return false;
+    }
+  }
+
+  // the chunks of the rows become the newest chunks of the table
+  if (NULL != rows->chunks)
+  {
+    TextTableChunk_t* pLast = rows->chunks;
+    while (NULL != pLast->nextChunk)
+    {
+      pLast = pLast->nextChunk;
+    }
+    pLast->nextChunk = table->chunks;
+    table->chunks = rows->chunks;
+  }
+  pCache->appendEnd = first + count;
+  pCache->appendPending++;
+  pCache->appendCopying++;
+  TextTableCells_t dest = *pCells;
+  TextTableUnlock(pCache);
+
+  memcpy(&dest.text[first], pSrc->text, count * sizeof(*dest.text));
+  memcpy(&dest.textLen[first], pSrc->textLen, count * sizeof(*dest.textLen));
+  memcpy(&dest.textCap[first], pSrc->textCap, count * sizeof(*dest.textCap));
+  memcpy(&dest.rowMaxTextLen[first], pSrc->rowMaxTextLen, count * sizeof(*dest.rowMaxTextLen));
+  for (size_t i = 0; i < count; i++)
+  {
+    dest.styleId[first + i] = styleMap[pSrc->styleId[i]];
+  }
+  memcpy(&dest.ansiSeqLen[first], pSrc->ansiSeqLen, count * sizeof(*dest.ansiSeqLen));
+  memcpy(&dest.flags[first], pSrc->flags, count * sizeof(*dest.flags));
+  memcpy(&dest.textRows[first], pSrc->textRows, count * sizeof(*dest.textRows));
+  if (NULL != pSrc->rowStart)
+  {
+    memcpy(&dest.rowStart[first], pSrc->rowStart, count * sizeof(*dest.rowStart));
+  }
+  else if (NULL != dest.rowStart)
+  {
+    memset(&dest.rowStart[first], 0, count * sizeof(*dest.rowStart));
+  }
+
+  // publish the rows after the rows of all earlier claims
+  TextTableLock(pCache);
+  pCache->appendCopying--;
+  while (table->entries != first)
+  {
+    TextTableLockYield(pCache);
+  }
+  TextTableLayoutMerge(table->layout, rows->layout, first, count);
+  table->entries += count;
+  pCache->appendPending--;
+  TextTableUnlock(pCache);
+
+  rows->chunks = NULL;
+  rows->entries = 0;
+  TextTableLayoutReset(rows->layout);
+  return true;
+}
+
+/**
+ * @brief   Move the width of one cell in the width counters of its column and update the column width.
+ *          A shrinking column searches the next smaller width with entries, at most
+ *          @ref TEXT_TABLE_MAX_COLUMN_LEN steps independent of the number of rows.
+ * @return  The new column width
+ */
+static size_t TextTableWidthMove(
+  size_t* pWidthCount,  ///< [in,out] Width counters of the column
+  size_t columnWidth,   ///< [in] Current column width
+  size_t oldWidth,      ///< [in] Old width of the cell
+  size_t newWidth)      ///< [in] New width of the cell
+{
+  pWidthCount[oldWidth]--;
+  pWidthCount[newWidth]++;
+  if (newWidth > columnWidth)
+  {
+    return newWidth;
+  }
+  while ((columnWidth > 0) && (0 == pWidthCount[columnWidth]))
+  {
+    columnWidth--;
+  }
+  return columnWidth;
+}
+
+/**
+ * @brief   Change one table entry in place.
+ *          - Only possible with declared columns (@ref TextTableInitColumns())
+ *          - The text storage of the cell is reused if the new text fits, otherwise new memory is taken
+ *            (with arena the old memory is released with the arena)
+ *          - A borrowed text (@ref TextTableAddRef()) is replaced by a copy
+ *          - The column width is updated incrementally, independent of the number of rows
+ * @retval true   success - the entry is changed
+ * @retval false  failed - the entry is unchanged
+ * @ingroup group_InterfaceFunctions
+ */
+bool TextTableSet(
+  TextTable_t* table,   ///< [in] The table
+  size_t row,           ///< [in] Row of the cell, beginning with 0
+  size_t column,        ///< [in] Column of the cell, beginning with 0
+  const char* ansiSeq,  ///< [in] ANSI-sequence string, closing tag will be added automatically
+  const char* format,   ///< [in] printf(...) like
+  ...)                  ///< [in] printf(...) like arguments
+{
+  if ((NULL == table) || (0 == table->columns) || (column >= table->columns) ||
+      (table->layout->columnCount != table->columns) || (NULL == table->layout->widthCount))
+  {
+    return false;
+  }
+  size_t idx = (row * table->columns) + column;
+  if ((idx / table->columns != row) || (idx >= table->entries))
+  {
+    return false;
+  }
+
+  char text[TEXT_TABLE_MAX_COLUMN_LEN + 1];
+  int formatLen = 0;
+  if (NULL != format)
+  {
+    va_list arg;
+    va_start(arg, format);
+    formatLen = vsnprintf(text, sizeof(text), format, arg);
+    va_end(arg);
+  }
+  size_t textLen = (formatLen < 0) ? 0 : (size_t)formatLen;
+  if (TEXT_TABLE_MAX_COLUMN_LEN < textLen)
+  {
+    textLen = TextTableUtf8Cut(text, TEXT_TABLE_MAX_COLUMN_LEN);
+  }
+  size_t ansiSeqLen = ((0 == textLen) || (NULL == ansiSeq)) ? 0 : strlen(ansiSeq);
+  if (TEXT_TABLE_MAX_ANSI_SEQ_LEN <= ansiSeqLen)
+  {
+    ansiSeqLen = 0;
+  }
+
+  T_TextScan scan;
+  TextTableScanText(text, textLen, &scan);
+
+  // take new memory first, so the cell is unchanged if this fails
+  uint8_t styleId = (0 == ansiSeqLen) ? 0 : TextTableStyleIntern(&table->styles, ansiSeq, ansiSeqLen);
+  if ((0 != ansiSeqLen) && (0 == styleId))
+  {
+    return false;
+  }
+  TextTableCells_t* pCells = &table->cells;
+  char* pText = (char*)pCells->text[idx];
+  bool newText = (NULL == pText) || (0 != (pCells->flags[idx] & TEXT_TABLE_CELL_BORROWED)) ||
+                 (textLen > pCells->textCap[idx]);
+  if (newText)
+  {
+    pText = (char*)TextTableAlloc(table, textLen + 1, 1);
+    if (NULL == pText)
+    {
+      return false;
+    }
+  }
+  uint8_t* pRowStart = (uint8_t*)TextTableRowStart(pCells, idx);
+  bool rowIndex = (1 != scan.textRows) || (textLen != scan.textEnd);
+  bool newRowStart = rowIndex && ((NULL == pRowStart) || (scan.textRows > pCells->textRows[idx]));
+  if (newRowStart && !TextTableRowIndex(table, &scan, textLen, &pRowStart))
+  {
+    if (newText && (0 == table->chunkSize))
+    {
+      free(pText);
+    }
+    return false;
+  }
+
+  // release replaced memory, without arena each text and row index has its own allocation
+  if (0 == table->chunkSize)
+  {
+    if (newText && (0 == (pCells->flags[idx] & TEXT_TABLE_CELL_BORROWED)))
+    {
+      free((void*)pCells->text[idx]);
+    }
+    if (newRowStart || !rowIndex)
+    {
+      free((void*)TextTableRowStart(pCells, idx));
+    }
+  }
+  size_t oldAnsiLen = TextTableCellAnsiLen(pCells, idx);
+  size_t oldUtf8Len = TextTableCellUtf8Len(pCells, idx);
+  if (newText)
+  {
+    pCells->textCap[idx] = (uint16_t)textLen;
+    pCells->flags[idx] &= (uint8_t)~TEXT_TABLE_CELL_BORROWED;
+  }
+  memcpy(pText, text, textLen);
+  pText[textLen] = 0x00;
+  pCells->text[idx] = pText;
+  pCells->textLen[idx] = (uint16_t)textLen;
+  pCells->styleId[idx] = styleId;
+  pCells->flags[idx] &= (uint8_t)~TEXT_TABLE_CELL_UTF8;
+  pCells->flags[idx] |= scan.utf8 ? TEXT_TABLE_CELL_UTF8 : 0;
+
+  if (!rowIndex)
+  {
+    pRowStart = NULL;
+  }
+  else if (!newRowStart)
+  {
+    memcpy(pRowStart, scan.rowStart, scan.textRows + 1);
+  }
+  if (NULL != pCells->rowStart)
+  {
+    pCells->rowStart[idx] = pRowStart;
+  }
+
+  // update the width of the column
+  size_t oldWidth = pCells->rowMaxTextLen[idx];
+  size_t newWidth = (0 == textLen) ? 0 : scan.rowMaxTextLen;
+  pCells->rowMaxTextLen[idx] = (uint16_t)newWidth;
+  pCells->textRows[idx] = (uint8_t)scan.textRows;
+  pCells->ansiSeqLen[idx] = (uint8_t)ansiSeqLen;
+
+  TextTableLayout_t* pLayout = table->layout;
+  T_Column* pColumn = &((T_Column*)pLayout->columns)[column];
+  size_t* pWidthCount = &pLayout->widthCount[column * TEXT_TABLE_WIDTH_COUNTS];
+  size_t rowMaxTextLen = TextTableWidthMove(pWidthCount, pColumn->rowMaxTextLen, oldWidth, newWidth);
+  if (rowMaxTextLen != pColumn->rowMaxTextLen)
+  {
+    pColumn->rowMaxTextLen = rowMaxTextLen;
+    pLayout->gridLen = 0;
+  }
+
+  // this row may now be the one with the most ANSI or multibyte character bytes, the maximum never shrinks
+  if (((TextTableCellAnsiLen(pCells, idx) != oldAnsiLen) || (TextTableCellUtf8Len(pCells, idx) != oldUtf8Len)) &&
+      !pLayout->fixed && (idx < pLayout->entries))
+  {
+    size_t ansiRowLen = 0;
+    size_t utf8RowLen = 0;
+    for (size_t cell = row * table->columns; cell < ((row + 1) * table->columns); cell++)
+    {
+      ansiRowLen += (cell < table->entries) ? TextTableCellAnsiLen(pCells, cell) : 0;
+      utf8RowLen += (cell < table->entries) ? TextTableCellUtf8Len(pCells, cell) : 0;
+    }
+    if ((ansiRowLen > pLayout->ansiMaxLen) || (utf8RowLen > pLayout->utf8MaxLen))
+    {
+      pLayout->ansiMaxLen = (ansiRowLen > pLayout->ansiMaxLen) ? ansiRowLen : pLayout->ansiMaxLen;
+      pLayout->utf8MaxLen = (utf8RowLen > pLayout->utf8MaxLen) ? utf8RowLen : pLayout->utf8MaxLen;
+      pLayout->gridLen = 0;
+    }
+    if (row == ((pLayout->entries - 1) / table->columns))
+    {
+      pLayout->ansiRowLen = ansiRowLen;
+      pLayout->utf8RowLen = utf8RowLen;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief         Direct access to the text of one table cell.
+ * @return        The text of the cell (not zero terminated) or NULL if the cell is empty or does not exist
+ * @ingroup       group_InterfaceFunctions
+ */
+const char* TextTableGetText(
+  const TextTable_t* table, ///< [in] The table
+  size_t columns,           ///< [in] Number of table columns
+  size_t row,               ///< [in] Row of the cell, beginning with 0
+  size_t column,            ///< [in] Column of the cell, beginning with 0
+  size_t* textLen)          ///< [out] Length of the text, may be NULL
+{
+  if ((NULL == table) || (column >= columns))
+  {
+    return NULL;
+  }
+  size_t idx = (row * columns) + column;
+  if ((idx / columns != row) || (idx >= table->entries))
+  {
+    return NULL;
+  }
+  if (NULL != textLen)
+  {
+    *textLen = table->cells.textLen[idx];
+  }
+  return (0 == table->cells.textLen[idx]) ? NULL : table->cells.text[idx];
+}
+
+/**
+ * @brief   Internal use - destination of the rendered lines
+ */
+typedef struct
+{
+  bool (*WriteLine)(void* context, const char* line, size_t lineLen); ///< Called for each zero terminated line
+  void* context;                                                        ///< Passed to WriteLine
+}T_Sink;
+
+/**
+ * @brief   Internal use - sink context of @ref TextTablePrint()
+ */
+typedef struct
+{
+  void(*PrintLineCallbackFunction)(const char* line); ///< The output callback function
+}T_PrintContext;
+
+/**
+ * @brief   Internal use - sink context of @ref TextTableRender()
+ */
+typedef struct
+{
+  char* buf;  ///< The output buffer, large enough for the whole table
+  size_t len; ///< Bytes written
+}T_RenderContext;
+
+/**
+ * @brief   Check the print arguments and calculate number of rows in the table.
+ * @return  Number of rows, 0 = invalid arguments
+ */
+static size_t TextTableRows(
+  const TextTable_t* table, ///< [in] The table
+  size_t posX,              ///< [in] Number of chars to right shift the table
+  size_t* columns)          ///< [in,out] Number of table columns, 0 is replaced by the declared columns
+{
+  if (NULL == table)
+  {
+    return 0;
+  }
+  if (posX > TEXT_TABLE_MAX_X_POS)
+  {
+    return 0;
+  }
+  if (*columns == 0)
+  {
+    *columns = table->columns;
+  }
+  if ((*columns == 0) || ((0 != table->columns) && (*columns != table->columns)))
+  {
+    return 0;
+  }
+  if (table->entries == 0)
+  {
+    return 0;
+  }
+
+  size_t rows = table->entries / *columns;
+  if (table->entries != (rows * *columns))
+  {
+    return 0;   // cannot calculate rows
+  }
+  return rows;
+}
+
+/**
+ * @brief   Fold the entries beginning with `firstEntry` into the max text length (width) of each column
+ *          and into the ANSI bytes per row, one linear sweep over the cell arrays.
+ * @retval true   at least one column width changed
+ * @retval false  the column widths are unchanged
+ */
+static bool TextTableMeasure(
+  const TextTable_t* table,   ///< [in] The table
+  TextTableLayout_t* pLayout, ///< [in,out] The layout
+  size_t columns,             ///< [in] Number of table columns
+  size_t firstEntry)          ///< [in] First entry not yet included in the column widths
+{
+  const TextTableCells_t* pCells = &table->cells;
+  T_Column* pColumn = (T_Column*)pLayout->columns;
+  bool changed = false;
+  size_t column = firstEntry % columns;
+  for (size_t cell = firstEntry; cell < table->entries; cell++)
+  {
+    if (pCells->rowMaxTextLen[cell] > pColumn[column].rowMaxTextLen)
+    {
+      pColumn[column].rowMaxTextLen = pCells->rowMaxTextLen[cell];
+      changed = true;
+    }
+    TextTableLayoutRow(pLayout, column, TextTableCellAnsiLen(pCells, cell), TextTableCellUtf8Len(pCells, cell));
+    if (++column == columns)
+    {
+      column = 0;
+    }
+  }
+  return changed;
+}
+
+/**
+ * @brief   Update the cached column layout of the table.
+ *          - Only the entries added since the last print are measured, fixed column widths are kept
+ *          - Row length and border lines are only rebuilt if a column width, the right shift
+ *            or the border characters changed
+ * @retval true   success
+ * @retval false  failed - no memory
+ */
+static bool TextTableLayoutUpdate(
+  const TextTable_t* table, ///< [in] The table
+  size_t posX,        ///< [in] Number of chars to right shift the table
+  size_t columns)     ///< [in] Number of table columns
+{
+  TextTableLayout_t* pLayout = table->layout;
+  if (pLayout->columnCount != columns)
+  {
+    if (!TextTableCtxReserve(&pLayout->columns, &pLayout->columnsCap, columns, sizeof(T_Column)))
+    {
+      pLayout->columnCount = 0;
+      return false;
+    }
+    memset(pLayout->columns, 0, sizeof(T_Column) * columns);
+    pLayout->columnCount = columns;
+    pLayout->entries = 0;
+    pLayout->ansiMaxLen = 0;
+    pLayout->ansiRowLen = 0;
+    pLayout->utf8MaxLen = 0;
+    pLayout->utf8RowLen = 0;
+    pLayout->gridLen = 0;
+  }
+  T_Column* pColumn = (T_Column*)pLayout->columns;
+  if (!pLayout->fixed && TextTableMeasure(table, pLayout, columns, pLayout->entries))
+  {
+    pLayout->gridLen = 0;
+  }
+  pLayout->entries = table->entries;
+
+  if ((0 != pLayout->gridLen) &&
+      (pLayout->gridPosX == posX) &&
+      (pLayout->gridSpaces == table->spacesBetweenBorder) &&
+      (pLayout->gridChars[0] == table->charGridX) &&
+      (pLayout->gridChars[1] == table->charHeadX) &&
+      (pLayout->gridChars[2] == table->charConnectorXY))
+  {
+    return true;
+  }
+
+  // calculate row length and grid length
+  // the row buffer fits the display width and the row with the most ANSI bytes
+  size_t rowLen = 2 + pLayout->ansiMaxLen + pLayout->utf8MaxLen; // + 1 '\0' zero terminated, + 1 opening column
+  size_t gridLen = posX + 1;
+  for (size_t i = 0; i < columns; i++)
+  {
+    rowLen += pColumn[i].rowMaxTextLen + (table->spacesBetweenBorder * 2) + 1; // +1 closing column character
+    gridLen += pColumn[i].rowMaxTextLen + (table->spacesBetweenBorder * 2) + 1;
+  }
+  if (!TextTableCtxReserve(&pLayout->gridBuf, &pLayout->gridBufSize, (gridLen + 1) * 2, 1))
+  {
+    pLayout->gridLen = 0;
+    return false;
+  }
+
+  // create border / header
+  char* gridBuf = pLayout->gridBuf;
+  char* headBuf = &pLayout->gridBuf[gridLen + 1];
+  memset(gridBuf, ' ', posX);
+  memset(headBuf, ' ', posX);
+  size_t idx = posX;
+  gridBuf[idx] = table->charConnectorXY;
+  headBuf[idx] = table->charConnectorXY;
+  idx++;
+  for (size_t i = 0; i < columns; i++)
+  {
+    size_t width = pColumn[i].rowMaxTextLen + (table->spacesBetweenBorder * 2);
+    memset(&gridBuf[idx], table->charGridX, width);
+    memset(&headBuf[idx], table->charHeadX, width);
+    idx += width;
+    gridBuf[idx] = table->charConnectorXY;
+    headBuf[idx] = table->charConnectorXY;
+    idx++;
+  }
+  gridBuf[idx] = '\0';
+  headBuf[idx] = '\0';
+
+  pLayout->rowLen = rowLen;
+  pLayout->gridLen = gridLen;
+  pLayout->gridPosX = posX;
+  pLayout->gridSpaces = table->spacesBetweenBorder;
+  pLayout->gridChars[0] = table->charGridX;
+  pLayout->gridChars[1] = table->charHeadX;
+  pLayout->gridChars[2] = table->charConnectorXY;
+  return true;
+}
+
+/**
+ * @brief   Bytes of the printed rows of a cell with multibyte characters beyond their display width.
+ */
+static size_t TextTableCellUtf8Output(
+  const TextTableCells_t* pCells, ///< [in] The cells
+  size_t cell,                    ///< [in] Index of the cell
+  size_t width)                   ///< [in] Width of the column
+{
+  const uint8_t* pRowStart = TextTableRowStart(pCells, cell);
+  size_t bytes = 0;
+  for (size_t textRow = 0; textRow < pCells->textRows[cell]; textRow++)
+  {
+    size_t rowStart = (NULL == pRowStart) ? 0 : pRowStart[textRow];
+    size_t textLen = (NULL == pRowStart) ? pCells->textLen[cell] : (pRowStart[textRow + 1] - 1 - rowStart);
+    size_t textWidth = 0;
+    if (0 != textLen)
+    {
+      bytes += TextTableTextFit(&pCells->text[cell][rowStart], textLen, width, &textWidth) - textWidth;
+    }
+  }
+  return bytes;
+}
+
+/**
+ * @brief   Calculate the exact output size of the table, each line terminated by `\n`.
+ * @return  Number of bytes
+ */
+static size_t TextTableOutputSize(
+  const TextTable_t* table, ///< [in] The table
+  const T_Column* pColumn,  ///< [in] The measured columns
+  TabStyle_e tabStyle,      ///< [in] The table style
+  size_t posX,              ///< [in] Number of chars to right shift the table
+  size_t columns,           ///< [in] Number of table columns
+  size_t rows)              ///< [in] Number of table rows
+{
+  const TextTableCells_t* pCells = &table->cells;
+
+  // grid lines and the text part of all lines have the same length
+  size_t gridLen = posX + 1;
+  size_t lineLen = posX;
+  for (size_t j = 0; j < columns; j++)
+  {
+    gridLen += pColumn[j].rowMaxTextLen + (table->spacesBetweenBorder * 2) + 1;
+    lineLen += pColumn[j].rowMaxTextLen + (table->spacesBetweenBorder * 2);
+  }
+  if (TABSTYLE_COMACT != tabStyle)
+  {
+    lineLen += columns + 1; // boundaries and separators
+  }
+  else
+  {
+    lineLen -= table->spacesBetweenBorder; // no spaces in front of the first column
+  }
+
+  size_t size = 0;
+  size_t cell = 0;
+  bool ansi = (TEXT_TABLE_ANSI_STRIP != table->ansiMode);
+  for (size_t i = 0; i < rows; i++)
+  {
+    size_t textRows = 1;
+    size_t rowLen = lineLen;
+    for (size_t j = 0; j < columns; j++, cell++)
+    {
+      if (pCells->textRows[cell] > textRows)
+      {
+        textRows = pCells->textRows[cell];
+      }
+      rowLen += ansi ? TextTableCellAnsiLen(pCells, cell) : 0;
+      if (0 != (pCells->flags[cell] & TEXT_TABLE_CELL_UTF8))
+      {
+        size += TextTableCellUtf8Output(pCells, cell, pColumn[j].rowMaxTextLen);
+      }
+    }
+    size += textRows * (rowLen + 1);
+  }
+
+  // grid lines
+  size_t gridLines = 0;
+  switch (tabStyle)
+  {
+  case TABSTYLE_COMACT:
+    break;
+  case TABSTYLE_REGULAR_HEAD_OFF:
+    gridLines = 2;
+    break;
+  case TABSTYLE_REGULAR_HEAD_ON:
+    gridLines = 3;
+    break;
+  case TABSTYLE_SEPARATED_HEAD_OFF:
+  case TABSTYLE_SEPARATED_HEAD_ON:
+    gridLines = 3 + ((rows > 2) ? (rows - 2) : 0);
+    break;
+  }
+  return size + (gridLines * (gridLen + 1));
+}
+
+/**
+ * @brief   Internal use - fixed part of a table line
+ */
+typedef struct
+{
+  const char* txt;  ///< The bytes
+  size_t len;       ///< Number of bytes
+  bool blank;       ///< Only spaces, the look does not depend on the style
+}T_Segment;
+
+/**
+ * @brief   Internal use - fixed parts of the table lines of one style, each line is put together with `memcpy()`
+ */
+typedef struct
+{
+  T_Segment headPrefix;   ///< In front of the first column of the header
+  T_Segment bodyPrefix;   ///< In front of the first column of the other rows
+  T_Segment separator;    ///< Between two columns
+  T_Segment headSuffix;   ///< Behind the last column of the header
+  T_Segment bodySuffix;   ///< Behind the last column of the other rows
+  const char* padding;    ///< @ref TEXT_TABLE_MAX_COLUMN_LEN spaces
+}T_Templates;
+
+/**
+ * @brief   Size of the template buffer of @ref TextTableTemplates()
+ */
+#define TEXT_TABLE_TEMPLATES_SIZE(spaces) (((spaces) * 6) + 5 + TEXT_TABLE_MAX_COLUMN_LEN)
+
+/**
+ * @brief   Build the fixed parts of the table lines of one style.
+ */
+static void TextTableTemplates(
+  const TextTable_t* table, ///< [in] The table
+  TabStyle_e tabStyle,      ///< [in] The table style
+  char* buf,                ///< [out] Template buffer of @ref TEXT_TABLE_TEMPLATES_SIZE() bytes
+  T_Templates* pTemplates)  ///< [out] The templates, pointing into `buf`
+{
+  size_t spaces = table->spacesBetweenBorder;
+  bool compact = (TABSTYLE_COMACT == tabStyle);
+  char headBoundary = table->charGridBoundary;
+  if ((TABSTYLE_REGULAR_HEAD_ON == tabStyle) || (TABSTYLE_SEPARATED_HEAD_ON == tabStyle))
+  {
+    headBoundary = table->charHeadBoundary;
+  }
+
+  // boundary + spaces, the compact style has no boundaries and no spaces in front of the first column
+  pTemplates->headPrefix.txt = buf;
+  pTemplates->headPrefix.len = compact ? 0 : (spaces + 1);
+  buf[0] = headBoundary;
+  memset(&buf[1], ' ', spaces);
+  buf += spaces + 1;
+  pTemplates->bodyPrefix.txt = buf;
+  pTemplates->bodyPrefix.len = pTemplates->headPrefix.len;
+  buf[0] = table->charGridBoundary;
+  memset(&buf[1], ' ', spaces);
+  buf += spaces + 1;
+
+  // spaces + separator + spaces
+  pTemplates->separator.txt = buf;
+  pTemplates->separator.len = compact ? (spaces * 2) : ((spaces * 2) + 1);
+  memset(buf, ' ', spaces);
+  buf += spaces;
+  if (!compact)
+  {
+    *buf++ = table->charGridSeparator;
+  }
+  memset(buf, ' ', spaces);
+  buf += spaces;
+
+  // spaces + boundary
+  pTemplates->headSuffix.txt = buf;
+  pTemplates->headSuffix.len = compact ? spaces : (spaces + 1);
+  memset(buf, ' ', spaces);
+  buf[spaces] = headBoundary;
+  buf += spaces + 1;
+  pTemplates->bodySuffix.txt = buf;
+  pTemplates->bodySuffix.len = pTemplates->headSuffix.len;
+  memset(buf, ' ', spaces);
+  buf[spaces] = table->charGridBoundary;
+  buf += spaces + 1;
+
+  pTemplates->padding = buf;
+  memset(buf, ' ', TEXT_TABLE_MAX_COLUMN_LEN);
+
+  // the compact style has no boundaries and separators
+  pTemplates->headPrefix.blank = compact;
+  pTemplates->bodyPrefix.blank = compact;
+  pTemplates->separator.blank = compact;
+  pTemplates->headSuffix.blank = compact;
+  pTemplates->bodySuffix.blank = compact;
+}
+
+/**
+ * @brief   Switch the active style of a line for @ref TEXT_TABLE_ANSI_MINIMAL.
+ *          Nothing is written if the active style already looks right: the same style or, for spaces, a style
+ *          that does not change spaces either. Otherwise the attributes are reset where needed and the
+ *          sequence of the style is written. Per cell at most one reset and one sequence are written,
+ *          which fits into the space of the sequence and @ref sAnsiSequenceEnd of @ref TEXT_TABLE_ANSI_FULL.
+ * @return  Number of bytes written
+ */
+static size_t TextTableAnsiSwitch(
+  const TextTableStyles_t* pStyles, ///< [in] The style table
+  char* buf,                        ///< [out] Output position in the row buffer
+  uint8_t* pActive,                 ///< [in,out] Active style of the line, 0 = default
+  uint8_t styleId,                  ///< [in] Style of the following bytes, 0 = default
+  bool blank)                       ///< [in] The following bytes are spaces
+{
+  uint8_t active = *pActive;
+  if (active == styleId)
+  {
+    return 0;
+  }
+  if (blank &&
+      ((0 == active) || (0 == (pStyles->flags[active - 1] & TEXT_TABLE_STYLE_BLANK_VISIBLE))) &&
+      ((0 == styleId) || (0 == (pStyles->flags[styleId - 1] & TEXT_TABLE_STYLE_BLANK_VISIBLE))))
+  {
+    return 0;
+  }
+  size_t len = 0;
+  if ((0 != active) && ((0 == styleId) || (0 == (pStyles->flags[styleId - 1] & TEXT_TABLE_STYLE_RESETS))))
+  {
+    memcpy(buf, sAnsiReset, sizeof(sAnsiReset));
+    len = sizeof(sAnsiReset);
+  }
+  if (0 != styleId)
+  {
+    memcpy(&buf[len], TextTableStyleSeq(pStyles, styleId), pStyles->seqLen[styleId - 1]);
+    len += pStyles->seqLen[styleId - 1];
+  }
+  *pActive = styleId;
+  return len;
+}
+
+/**
+ * @brief   Render the table rows `[firstRow, lastRow)` line by line into the sink.
+ *          The first table row is the header, it is only rendered in the header style if it is part of the output.
+ * @retval true   success
+ * @retval false  failed - no memory or the sink failed
+ */
+static bool TextTableRenderLines(
+  const TextTable_t* table,       ///< [in] The table with up to date layout
+  TextTableRenderCtx_t* pCtx,     ///< [in] Render context, provides the layout and the row buffer
+  const T_Sink* pSink,            ///< [in] Destination of the lines
+  TabStyle_e tabStyle,            ///< [in] The table style
+  size_t posX,                    ///< [in] Number of chars to right shift the table
+  size_t columns,                 ///< [in] Number of table columns
+  size_t firstRow,                ///< [in] First row to render
+  size_t lastRow,                 ///< [in] End of the rows to render (exclusive)
+  uint8_t renderFlags)            ///< [in] Render flags, e.g. @ref TEXT_TABLE_RENDER_HEAD
+{
+  const TextTableCells_t* pCells = &table->cells;
+  const TextTableLayout_t* pLayout = &pCtx->layout;
+  const T_Column* pColumn = (const T_Column*)pLayout->columns;
+  char* rowBuf = pCtx->lineBuf;
+  memset(rowBuf, ' ', posX);
+  T_Templates templates;
+  TextTableTemplates(table, tabStyle, &pCtx->lineBuf[pLayout->rowLen + posX], &templates);
+
+  const char* gridBuf = pLayout->gridBuf;
+  const char* headBuf = &pLayout->gridBuf[pLayout->gridLen + 1];
+  size_t gridLen = pLayout->gridLen;
+  bool minimal = (TEXT_TABLE_ANSI_MINIMAL == table->ansiMode);
+  bool wrap = !minimal && (TEXT_TABLE_ANSI_STRIP != table->ansiMode); // each styled cell in sequence and reset
+  uint8_t active = 0; // active style of the line with TEXT_TABLE_ANSI_MINIMAL
+
+  // print table
+  // rows
+  bool ok = true;
+  bool firstTableLine = true;
+  size_t i = (0 != (renderFlags & TEXT_TABLE_RENDER_HEAD)) ? 0 : firstRow;
+  for (; ok && (i < lastRow); i = ((0 == i) && (firstRow > 1)) ? firstRow : (i + 1))
+  {
+    bool newLine = false;
+    size_t textRow = 0;
+    // columns
+    const T_Segment* pPrefix = (0 == i) ? &templates.headPrefix : &templates.bodyPrefix;
+    const T_Segment* pSuffix = (0 == i) ? &templates.headSuffix : &templates.bodySuffix;
+    do
+    {
+      size_t idxRow = posX;
+      newLine = false;
+
+      memcpy(&rowBuf[idxRow], pPrefix->txt, pPrefix->len);
+      idxRow += pPrefix->len;
+      for (size_t j = 0; j < columns; j++)
+      {
+        size_t cell = (i * columns) + j;
+        uint8_t styleId = pCells->styleId[cell];
+        if (0 != j)
+        {
+          if (minimal)
+          {
+            idxRow += TextTableAnsiSwitch(&table->styles, &rowBuf[idxRow], &active, 0, templates.separator.blank);
+          }
+          memcpy(&rowBuf[idxRow], templates.separator.txt, templates.separator.len);
+          idxRow += templates.separator.len;
+        }
+
+        // ansi sequence start
+        if (wrap && (0 != styleId))
+        {
+          memcpy(&rowBuf[idxRow], TextTableStyleSeq(&table->styles, styleId), pCells->ansiSeqLen[cell]);
+          idxRow = idxRow + pCells->ansiSeqLen[cell];
+        }
+
+        // write column row: the text row taken from the row index, then padding
+        size_t width = pColumn[j].rowMaxTextLen;
+        size_t textRows = pCells->textRows[cell];
+        size_t rowStart = 0;
+        size_t textLen = 0;
+        if (textRow < textRows)
+        {
+          const uint8_t* pRowStart = TextTableRowStart(pCells, cell);
+          if (NULL == pRowStart)
+          {
+            textLen = pCells->textLen[cell];
+          }
+          else
+          {
+            rowStart = pRowStart[textRow];
+            textLen = pRowStart[textRow + 1] - 1 - rowStart;
+          }
+          newLine = newLine || ((textRow + 1) < textRows);
+        }
+        size_t textWidth = textLen;
+        if ((0 != textLen) && (0 != (pCells->flags[cell] & TEXT_TABLE_CELL_UTF8)))
+        {
+          textLen = TextTableTextFit(&pCells->text[cell][rowStart], textLen, width, &textWidth);
+        }
+        else if (textLen > width) // fixed column widths
+        {
+          textLen = width;
+          textWidth = width;
+        }
+        if (0 != textLen)
+        {
+          if (minimal)
+          {
+            idxRow += TextTableAnsiSwitch(&table->styles, &rowBuf[idxRow], &active, styleId, false);
+          }
+          memcpy(&rowBuf[idxRow], &pCells->text[cell][rowStart], textLen);
+          idxRow += textLen;
+        }
+        if (minimal && (textWidth != width))
+        {
+          idxRow += TextTableAnsiSwitch(&table->styles, &rowBuf[idxRow], &active, styleId, true);
+        }
+        memcpy(&rowBuf[idxRow], templates.padding, width - textWidth);
+        idxRow += width - textWidth;
+
+        // ansi sequence end
+        if (wrap && (0 != styleId))
+        {
+          memcpy(&rowBuf[idxRow], sAnsiSequenceEnd, sizeof(sAnsiSequenceEnd));
+          idxRow = idxRow + sizeof(sAnsiSequenceEnd);
+        }
+      }
+      if (minimal)
+      {
+        idxRow += TextTableAnsiSwitch(&table->styles, &rowBuf[idxRow], &active, 0, pSuffix->blank);
+      }
+      memcpy(&rowBuf[idxRow], pSuffix->txt, pSuffix->len);
+      idxRow += pSuffix->len;
+      if (0 != active) // the line ends with the default style
+      {
+        memcpy(&rowBuf[idxRow], sAnsiReset, sizeof(sAnsiReset));
+        idxRow += sizeof(sAnsiReset);
+        active = 0;
+      }
+      rowBuf[idxRow] = 0x00; // zero terminated
+
+      // first line
+      if (firstTableLine && (0 != (renderFlags & TEXT_TABLE_RENDER_SEPARATE)))
+      {
+        switch (tabStyle)
+        {
+        case TABSTYLE_COMACT:
+        case TABSTYLE_REGULAR_HEAD_ON:
+        case TABSTYLE_REGULAR_HEAD_OFF:
+          break;
+        case TABSTYLE_SEPARATED_HEAD_OFF:
+        case TABSTYLE_SEPARATED_HEAD_ON:
+          ok = ok && pSink->WriteLine(pSink->context, gridBuf, gridLen);
+          break;
+        }
+      }
+      else if (firstTableLine && (0 == (renderFlags & TEXT_TABLE_RENDER_CONTINUE)))
+      {
+        switch (tabStyle)
+        {
+        case TABSTYLE_COMACT:
+          break;
+        case TABSTYLE_REGULAR_HEAD_OFF:
+        case TABSTYLE_SEPARATED_HEAD_OFF:
+          ok = ok && pSink->WriteLine(pSink->context, gridBuf, gridLen);
+          break;
+        case TABSTYLE_REGULAR_HEAD_ON:
+        case TABSTYLE_SEPARATED_HEAD_ON:
+          ok = ok && pSink->WriteLine(pSink->context, (0 == i) ? headBuf : gridBuf, gridLen);
+          break;
+        }
+      }
+      ok = ok && pSink->WriteLine(pSink->context, rowBuf, idxRow);
+      firstTableLine = false;
+      textRow++;
+
+    }
+    while (ok && newLine);
+
+    if (i == 0) // first row, closing line of header
+    {
+      switch (tabStyle)
+      {
+      case TABSTYLE_COMACT:
+      case TABSTYLE_REGULAR_HEAD_OFF:
+        // no closing line
+        break;
+      case TABSTYLE_SEPARATED_HEAD_OFF:
+        ok = ok && pSink->WriteLine(pSink->context, gridBuf, gridLen);
+        break;
+      case TABSTYLE_REGULAR_HEAD_ON:
+      case TABSTYLE_SEPARATED_HEAD_ON:
+        ok = ok && pSink->WriteLine(pSink->context, headBuf, gridLen);
+        break;
+      }
+    }
+    else if (i < (lastRow - 1)) // between rows
+    {
+      switch (tabStyle)
+      {
+      case TABSTYLE_COMACT:
+      case TABSTYLE_REGULAR_HEAD_ON:
+      case TABSTYLE_REGULAR_HEAD_OFF:
+        // no line
+        break;
+      case TABSTYLE_SEPARATED_HEAD_OFF:
+      case TABSTYLE_SEPARATED_HEAD_ON:
+        ok = ok && pSink->WriteLine(pSink->context, gridBuf, gridLen);
+        break;
+      }
+    }
+  }
+  if ((TABSTYLE_COMACT != tabStyle) && (0 == (renderFlags & TEXT_TABLE_RENDER_OPEN)))
+  {
+    ok = ok && pSink->WriteLine(pSink->context, gridBuf, gridLen);
+  }
+
+  return ok;
+}
+
+/**
+ * @brief   Sink of @ref TextTablePrint(), passes the line to the output callback function.
+ */
+static bool TextTablePrintLine(void* context, const char* line, size_t lineLen)
+{
+  (void)lineLen;
+  ((T_PrintContext*)context)->PrintLineCallbackFunction(line);
+  return true;
+}
+
+/**
+ * @brief   Internal use - sink context of @ref TextTablePrintBatch()
+ */
+typedef struct
+{
+  TextTableRenderCtx_t* pCtx;                     ///< Render context with the batch buffers
+  TextTableLinesCallback_t LinesCallbackFunction; ///< The output callback function
+  void* context;                                  ///< Context pointer of the caller
+  size_t count;                                   ///< Number of lines in the batch
+  size_t len;                                     ///< Bytes used in the batch buffer
+}T_BatchContext;
+
+/**
+ * @brief   Pass the collected lines to the callback function of @ref TextTablePrintBatch().
+ */
+static void TextTableBatchFlush(T_BatchContext* pContext) ///< [in] The sink context
+{
+  if (0 != pContext->count)
+  {
+    pContext->LinesCallbackFunction(pContext->context, pContext->pCtx->batchLines, pContext->pCtx->batchLens,
+                                    pContext->count);
+    pContext->count = 0;
+    pContext->len = 0;
+  }
+}
+
+/**
+ * @brief   Sink of @ref TextTablePrintBatch(), appends the line and `\n` to the batch,
+ *          a full batch is passed to the callback function first.
+ */
+static bool TextTableBatchLine(void* context, const char* line, size_t lineLen)
+{
+  T_BatchContext* pContext = (T_BatchContext*)context;
+  TextTableRenderCtx_t* pCtx = pContext->pCtx;
+  if ((TEXT_TABLE_BATCH_LINES == pContext->count) || ((pContext->len + lineLen + 1) > pCtx->batchBufSize))
+  {
+    TextTableBatchFlush(pContext);
+  }
+  char* pLine = &pCtx->batchBuf[pContext->len];
+  memcpy(pLine, line, lineLen);
+  pLine[lineLen] = '\n';
+  pCtx->batchLines[pContext->count] = pLine;
+  pCtx->batchLens[pContext->count] = lineLen + 1;
+  pContext->count++;
+  pContext->len += lineLen + 1;
+  return true;
+}
+
+/**
+ * @brief   Sink of @ref TextTableRender(), appends the line and `\n` to the output buffer.
+ */
+static bool TextTableRenderLine(void* context, const char* line, size_t lineLen)
+{
+  T_RenderContext* pContext = (T_RenderContext*)context;
+  memcpy(&pContext->buf[pContext->len], line, lineLen);
+  pContext->buf[pContext->len + lineLen] = '\n';
+  pContext->len += lineLen + 1;
+  return true;
+}
+
+/**
+ * @brief         Initialize a render context.
+ *                A render context keeps the buffers of @ref TextTablePrintCtx() and @ref TextTableRenderCtx()
+ *                between the calls, so printing the same table again does not allocate memory.
+ * @retval true   success
+ * @retval false  failed
+ * @ingroup       group_InterfaceFunctions
+ */
+bool TextTableRenderCtxInit(TextTableRenderCtx_t* ctx) ///< [in] The render context
+{
+  if (NULL == ctx)
+  {
+    return false;
+  }
+  memset(&ctx->layout, 0, sizeof(ctx->layout));
+  ctx->lineBuf = NULL;
+  ctx->lineBufSize = 0;
+  ctx->batchBuf = NULL;
+  ctx->batchBufSize = 0;
+  return true;
+}
+
+/**
+ * @brief   Release the buffers of a render context.
+ * @ingroup group_InterfaceFunctions
+ */
+void TextTableRenderCtxFree(TextTableRenderCtx_t* ctx) ///< [in] The render context
+{
+  if (NULL != ctx)
+  {
+    free(ctx->layout.columns);
+    free(ctx->layout.gridBuf);
+    free(ctx->lineBuf);
+    free(ctx->batchBuf);
+    TextTableRenderCtxInit(ctx);
+  }
+}
+
+/**
+ * @brief   Copy the parts of a layout used for rendering into the layout of a render context.
+ * @retval true   success
+ * @retval false  failed - no memory
+ */
+static bool TextTableLayoutCopy(
+  TextTableLayout_t* pDest,       ///< [out] Layout of the render context
+  const TextTableLayout_t* pSrc)  ///< [in] Up to date layout of the table
+{
+  if (!TextTableCtxReserve(&pDest->columns, &pDest->columnsCap, pSrc->columnCount, sizeof(T_Column)) ||
+      !TextTableCtxReserve(&pDest->gridBuf, &pDest->gridBufSize, (pSrc->gridLen + 1) * 2, 1))
+  {
+    return false;
+  }
+  memcpy(pDest->columns, pSrc->columns, pSrc->columnCount * sizeof(T_Column));
+  memcpy(pDest->gridBuf, pSrc->gridBuf, (pSrc->gridLen + 1) * 2);
+  pDest->columnCount = pSrc->columnCount;
+  pDest->ansiMaxLen = pSrc->ansiMaxLen;
+  pDest->rowLen = pSrc->rowLen;
+  pDest->gridLen = pSrc->gridLen;
+  return true;
+}
+
+/**
+ * @brief   Update the layout of the table and copy it into the render context, make sure the context can hold
+ *          the lines. The layout of the table is a cache: it is only changed under its lock, so a print does not
+ *          change what other prints of the same table read.
+ * @return  Length of the row buffer (longest line including zero termination), 0 = no memory
+ */
+static size_t TextTableCtxPrepare(
+  const TextTable_t* table,   ///< [in] The table
+  TextTableRenderCtx_t* pCtx, ///< [in] The render context
+  size_t posX,                ///< [in] Number of chars to right shift the table
+  size_t columns)             ///< [in] Number of table columns
+{
+  T_LayoutCache* pCache = TextTableCache(table);
+  TextTableLock(pCache);
+  bool ok = TextTableLayoutUpdate(table, posX, columns) && TextTableLayoutCopy(&pCtx->layout, table->layout);
+  TextTableUnlock(pCache);
+  if (!ok)
+  {
+    return 0;
+  }
+  if (TEXT_TABLE_ANSI_STRIP == table->ansiMode) // the row buffer is sized for plain output
+  {
+    pCtx->layout.rowLen -= pCtx->layout.ansiMaxLen;
+    pCtx->layout.ansiMaxLen = 0;
+  }
+  size_t rowLen = pCtx->layout.rowLen + posX;
+  if (!TextTableCtxReserve(&pCtx->lineBuf, &pCtx->lineBufSize,
+                           rowLen + TEXT_TABLE_TEMPLATES_SIZE(table->spacesBetweenBorder), 1))
+  {
+    return 0;
+  }
+  return rowLen;
+}
+
+/**
+ * @brief         Print the table line by line to the registered output-callback-function.
+ *                The buffers of the render context are reused, so once the context is large enough
+ *                no memory is allocated. Several threads can print the same table at once, each with
+ *                its own render context, as long as no thread changes the table meanwhile.
+ * @retval true   success
+ * @retval false  failed
+ * @ingroup       group_InterfaceFunctions
+ */
+bool TextTablePrintCtx(
+  const TextTable_t* table,                           ///< [in] The table.
+  TextTableRenderCtx_t* ctx,                          ///< [in] The render context.
+  void(*PrintLineCallbackFunction)(const char* line), ///< [in] Function pointer to output function.
+  TabStyle_e tabStyle,                                ///< [in] Choose one of the styles.
+  size_t posX,                                        ///< [in] Number of chars to right shift the table.
+  size_t columns)                                     ///< [in] Number of table columns, 0 = declared columns.
+{
+  if ((NULL == ctx) || (NULL == PrintLineCallbackFunction))
+  {
+    return false;
+  }
+  size_t rows = TextTableRows(table, posX, &columns);
+  if (0 == rows)
+  {
+    return false;
+  }
+  if (0 == TextTableCtxPrepare(table, ctx, posX, columns))
+  {
+    return false;
+  }
+
+  T_PrintContext context = {PrintLineCallbackFunction};
+  T_Sink sink = {TextTablePrintLine, &context};
+  return TextTableRenderLines(table, ctx, &sink, tabStyle, posX, columns, 0, rows, 0);
+}
+
+/**
+ * @brief         Print only the table rows `[firstRow, lastRow)`, e.g. one page of a large table.
+ *                The columns have the width of the whole table, so all pages are aligned. The rows are
+ *                framed like a complete table, the header (first table row) can be repeated on top of each page.
+ *                Only the rows of the page are visited, the column widths are taken from the cached layout.
+ * @retval true   success
+ * @retval false  failed - invalid arguments or empty range
+ * @ingroup       group_InterfaceFunctions
+ */
+bool TextTablePrintRange(
+  const TextTable_t* table,                           ///< [in] The table.
+  TextTableRenderCtx_t* ctx,                          ///< [in] The render context.
+  void(*PrintLineCallbackFunction)(const char* line), ///< [in] Function pointer to output function.
+  TabStyle_e tabStyle,                                ///< [in] Choose one of the styles.
+  size_t posX,                                        ///< [in] Number of chars to right shift the table.
+  size_t columns,                                     ///< [in] Number of table columns, 0 = declared columns.
+  size_t firstRow,                                    ///< [in] First row to print, beginning with 0 (header)
+  size_t lastRow,                                     ///< [in] End of the rows to print (exclusive)
+  bool repeatHead)                                    ///< [in] true = print the header on top of the rows
+{
+  if ((NULL == ctx) || (NULL == PrintLineCallbackFunction))
+  {
+    return false;
+  }
+  size_t rows = TextTableRows(table, posX, &columns);
+  if ((0 == rows) || (firstRow >= lastRow) || (lastRow > rows))
+  {
+    return false;
+  }
+  if (0 == TextTableCtxPrepare(table, ctx, posX, columns))
+  {
+    return false;
+  }
+
+  T_PrintContext context = {PrintLineCallbackFunction};
+  T_Sink sink = {TextTablePrintLine, &context};
+  return TextTableRenderLines(table, ctx, &sink, tabStyle, posX, columns, firstRow, lastRow,
+                              repeatHead ? TEXT_TABLE_RENDER_HEAD : 0);
+}
+
+/**
+ * @brief         Print the table to a callback function that receives the lines in batches of up to
+ *                @ref TEXT_TABLE_BATCH_LINES lines, together with their lengths and a context pointer of the caller.
+ *                A sink can write each batch with one `write()` or `writev()` instead of one call per line.
+ *                The lines are collected in the render context, so once it is large enough no memory is allocated.
+ * @retval true   success
+ * @retval false  failed
+ * @ingroup       group_InterfaceFunctions
+ */
+bool TextTablePrintBatch(
+  const TextTable_t* table,                       ///< [in] The table.
+  TextTableRenderCtx_t* ctx,                      ///< [in] The render context, NULL = temporary context.
+  TextTableLinesCallback_t LinesCallbackFunction, ///< [in] Function pointer to output function.
+  void* context,                                  ///< [in] Passed to the output function.
+  TabStyle_e tabStyle,                            ///< [in] Choose one of the styles.
+  size_t posX,                                    ///< [in] Number of chars to right shift the table.
+  size_t columns)                                 ///< [in] Number of table columns, 0 = declared columns.
+{
+  if (NULL == ctx)
+  {
+    TextTableRenderCtx_t tempCtx;
+    TextTableRenderCtxInit(&tempCtx);
+    bool ok = TextTablePrintBatch(table, &tempCtx, LinesCallbackFunction, context, tabStyle, posX, columns);
+    TextTableRenderCtxFree(&tempCtx);
+    return ok;
+  }
+  if (NULL == LinesCallbackFunction)
+  {
+    return false;
+  }
+  size_t rows = TextTableRows(table, posX, &columns);
+  if (0 == rows)
+  {
+    return false;
+  }
+  size_t rowLen = TextTableCtxPrepare(table, ctx, posX, columns);
+  if ((0 == rowLen) ||
+      !TextTableCtxReserve(&ctx->batchBuf, &ctx->batchBufSize,
+                           (rowLen > TEXT_TABLE_BATCH_SIZE) ? rowLen : TEXT_TABLE_BATCH_SIZE, 1))
+  {
+    return false;
+  }
+
+  T_BatchContext batchContext = {ctx, LinesCallbackFunction, context, 0, 0};
+  T_Sink sink = {TextTableBatchLine, &batchContext};
+  bool ok = TextTableRenderLines(table, ctx, &sink, tabStyle, posX, columns, 0, rows, 0);
+  TextTableBatchFlush(&batchContext);
+  return ok;
+}
+
+/**
+ * @brief         Print the table line by line to the registered output-callback-function.
+ *                Several threads can print the same table at once, as long as no thread changes the table meanwhile.
+ * @retval true   success
+ * @retval false  failed
+ * @ingroup       group_InterfaceFunctions
+ */
+bool TextTablePrint(
+  const TextTable_t* table,                           ///< [in] The table.
+  void(*PrintLineCallbackFunction)(const char* line), ///< [in] Function pointer to output function.
+  TabStyle_e tabStyle,                                ///< [in] Choose one of the styles.
+  size_t posX,                                        ///< [in] Number of chars to right shift the table.
+  size_t columns)                                     ///< [in] Number of table columns, 0 = declared columns
+                                                      /// (@ref TextTableInitColumns()).
+                                                      /// Please note that only an __even__ number of entries added with
+                                                      /// @ref TextTableAdd() will work. Otherwise the rows cannot calculated.
+{
+  TextTableRenderCtx_t ctx;
+  TextTableRenderCtxInit(&ctx);
+  bool ok = TextTablePrintCtx(table, &ctx, PrintLineCallbackFunction, tabStyle, posX, columns);
+  TextTableRenderCtxFree(&ctx);
+  return ok;
+}
+
+/**
+ * @brief         Render the whole table into one contiguous buffer, each line is terminated by `\n`.
+ *                The output size is calculated first, so the buffer is either filled completely or
+ *                left untouched. With @ref TEXT_TABLE_ANSI_MINIMAL the size is an upper bound and the
+ *                output may be shorter. The output is not zero terminated.
+ *                The buffers of the render context are reused, see @ref TextTablePrintCtx().
+ * @return        Number of bytes written, 0 = invalid arguments or the buffer is too small
+ * @ingroup       group_InterfaceFunctions
+ */
+size_t TextTableRenderCtx(
+  const TextTable_t* table,   ///< [in] The table.
+  TextTableRenderCtx_t* ctx,  ///< [in] The render context.
+  TabStyle_e tabStyle,        ///< [in] Choose one of the styles.
+  size_t posX,                ///< [in] Number of chars to right shift the table.
+  size_t columns,             ///< [in] Number of table columns, 0 = declared columns.
+  char* buf,                  ///< [out] The output buffer, may be NULL if `cap` is 0
+  size_t cap,                 ///< [in] Size of the output buffer
+  size_t* needed)             ///< [out] Output size of the table (upper bound with TEXT_TABLE_ANSI_MINIMAL), 0 = invalid arguments, may be NULL
+{
+  if (NULL != needed)
+  {
+    *needed = 0;
+  }
+  if (NULL == ctx)
+  {
+    return 0;
+  }
+  size_t rows = TextTableRows(table, posX, &columns);
+  if (0 == rows)
+  {
+    return 0;
+  }
+  if (0 == TextTableCtxPrepare(table, ctx, posX, columns))
+  {
+    return 0;
+  }
+
+  size_t size = TextTableOutputSize(table, (const T_Column*)ctx->layout.columns, tabStyle, posX, columns, rows);
+  if (NULL != needed)
+  {
+    *needed = size;
+  }
+  if ((NULL == buf) || (cap < size))
+  {
+    return 0;
+  }
+
+  T_RenderContext context = {buf, 0};
+  T_Sink sink = {TextTableRenderLine, &context};
+  bool ok = TextTableRenderLines(table, ctx, &sink, tabStyle, posX, columns, 0, rows, 0);
+  return ok ? context.len : 0;
+}
+
+/**
+ * @brief         Render the whole table into one contiguous buffer, each line is terminated by `\n`.
+ *                The output size is calculated first, so the buffer is either filled completely or
+ *                left untouched. With @ref TEXT_TABLE_ANSI_MINIMAL the size is an upper bound and the
+ *                output may be shorter. The output is not zero terminated.
+ * @return        Number of bytes written, 0 = invalid arguments or the buffer is too small
+ * @ingroup       group_InterfaceFunctions
+ */
+size_t TextTableRender(
+  const TextTable_t* table, ///< [in] The table.
+  TabStyle_e tabStyle,      ///< [in] Choose one of the styles.
+  size_t posX,              ///< [in] Number of chars to right shift the table.
+  size_t columns,           ///< [in] Number of table columns, 0 = declared columns.
+  char* buf,                ///< [out] The output buffer, may be NULL if `cap` is 0
+  size_t cap,               ///< [in] Size of the output buffer
+  size_t* needed)           ///< [out] Output size of the table (upper bound with TEXT_TABLE_ANSI_MINIMAL), 0 = invalid arguments, may be NULL
+{
+  TextTableRenderCtx_t ctx;
+  TextTableRenderCtxInit(&ctx);
+  size_t len = TextTableRenderCtx(table, &ctx, tabStyle, posX, columns, buf, cap, needed);
+  TextTableRenderCtxFree(&ctx);
+  return len;
+}
+
+#ifndef __STDC_NO_THREADS__
+/**
+ * @brief   Internal use - lines of one block of table rows rendered by a worker of @ref TextTablePrintParallel()
+ */
+typedef struct
+{
+  char* buf;        ///< The lines, each one terminated by `\n`
+  size_t len;       ///< Bytes used in the buffer
+  size_t size;      ///< Size of the buffer
+  size_t* lens;     ///< Length of each line including `\n`
+  size_t lines;     ///< Number of lines in the buffer
+  size_t linesCap;  ///< Capacity of `lens`
+  size_t block;     ///< Index of the block in the buffer
+  bool done;        ///< The block is rendered and not yet delivered
+  bool ok;          ///< The block was rendered successfully
+}T_Block;
+
+/**
+ * @brief   Sink of the blocks of @ref TextTablePrintParallel(), appends the line and `\n` to the block and keeps
+ *          its length. The buffers grow by doubling and are reused for the following blocks.
+ */
+static bool TextTableBlockLine(void* context, const char* line, size_t lineLen)
+{
+  T_Block* pBlock = (T_Block*)context;
+  size_t needed = pBlock->len + lineLen + 1;
+  if ((needed > pBlock->size) &&
+      !TextTableCtxReserve(&pBlock->buf, &pBlock->size, (needed > (pBlock->size * 2)) ? needed : (pBlock->size * 2), 1))
+  {
+    return false;
+  }
+  if ((pBlock->lines == pBlock->linesCap) &&
+      !TextTableCtxReserve(&pBlock->lens, &pBlock->linesCap, (0 == pBlock->linesCap) ? 64 : (pBlock->linesCap * 2),
+                           sizeof(*pBlock->lens)))
+  {
+    return false;
+  }
+  memcpy(&pBlock->buf[pBlock->len], line, lineLen);
+  pBlock->buf[pBlock->len + lineLen] = '\n';
+  pBlock->lens[pBlock->lines] = lineLen + 1;
+  pBlock->lines++;
+  pBlock->len = needed;
+  return true;
+}
+
+/**
+ * @brief   Render the table rows of one block. The block is framed so that the blocks put together in order
+ *          give exactly the lines of the whole table.
+ * @retval true   success
+ * @retval false  failed - no memory
+ */
+static bool TextTableRenderBlock(
+  const TextTable_t* table,   ///< [in] The table
+  TextTableRenderCtx_t* pCtx, ///< [in] Prepared render context
+  T_Block* pBlock,            ///< [out] The lines of the block
+  TabStyle_e tabStyle,        ///< [in] The table style
+  size_t posX,                ///< [in] Number of chars to right shift the table
+  size_t columns,             ///< [in] Number of table columns
+  size_t firstRow,            ///< [in] First row of the block
+  size_t lastRow,             ///< [in] End of the rows of the block (exclusive)
+  size_t rows)                ///< [in] Number of table rows
+{
+  uint8_t renderFlags = 0;
+  if (0 < firstRow)
+  {
+    renderFlags |= TEXT_TABLE_RENDER_CONTINUE;
+  }
+  if (1 < firstRow) // the header closes itself
+  {
+    renderFlags |= TEXT_TABLE_RENDER_SEPARATE;
+  }
+  if (lastRow < rows)
+  {
+    renderFlags |= TEXT_TABLE_RENDER_OPEN;
+  }
+  T_Sink sink = {TextTableBlockLine, pBlock};
+  pBlock->len = 0;
+  pBlock->lines = 0;
+  return TextTableRenderLines(table, pCtx, &sink, tabStyle, posX, columns, firstRow, lastRow, renderFlags);
+}
+
+/**
+ * @brief   Pass the lines of a rendered block to the callback function of @ref TextTablePrintParallel(),
+ *          in batches of at most @ref TEXT_TABLE_BATCH_LINES lines.
+ */
+static void TextTableBlockDeliver(
+  const T_Block* pBlock,                          ///< [in] The rendered block
+  TextTableLinesCallback_t LinesCallbackFunction, ///< [in] The output callback function
+  void* context)                                  ///< [in] Context pointer of the caller
+{
+  const char* lines[TEXT_TABLE_BATCH_LINES];
+  const char* pLine = pBlock->buf;
+  for (size_t first = 0; first < pBlock->lines; first += TEXT_TABLE_BATCH_LINES)
+  {
+    size_t count = ((pBlock->lines - first) > TEXT_TABLE_BATCH_LINES) ? TEXT_TABLE_BATCH_LINES :
+                   (pBlock->lines - first);
+    for (size_t i = 0; i < count; i++)
+    {
+      lines[i] = pLine;
+      pLine += pBlock->lens[first + i];
+    }
+    LinesCallbackFunction(context, lines, &pBlock->lens[first], count);
+  }
+}
+
+/**
+ * @brief   Internal use - state shared by the caller and the workers of @ref TextTablePrintParallel()
+ */
+typedef struct
+{
+  const TextTable_t* table; ///< The table
+  TabStyle_e tabStyle;      ///< The table style
+  size_t posX;              ///< Number of chars to right shift the table
+  size_t columns;           ///< Number of table columns
+  size_t rows;              ///< Number of table rows
+  size_t blockRows;         ///< Number of table rows per block
+  size_t blocks;            ///< Number of blocks
+  T_Block* pSlots;          ///< Buffers of the blocks in work, block `n` uses slot `n % slots`
+  size_t slots;             ///< Number of block buffers
+  size_t nextBlock;         ///< Next block to be rendered by a worker
+  size_t delivered;         ///< Number of blocks passed to the callback function
+  bool abort;               ///< Stop rendering, a block failed
+  mtx_t lock;               ///< Guards the members above
+  cnd_t changed;            ///< Signaled when a block is rendered or delivered
+}T_Parallel;
+
+/**
+ * @brief   Worker of @ref TextTablePrintParallel(): takes the next block, as soon as its buffer is delivered,
+ *          and renders it with its own render context.
+ */
+static int TextTableParallelWorker(void* arg) ///< [in] The shared state
+{
+  T_Parallel* pParallel = (T_Parallel*)arg;
+  TextTableRenderCtx_t ctx;
+  TextTableRenderCtxInit(&ctx);
+  size_t rowLen = TextTableCtxPrepare(pParallel->table, &ctx, pParallel->posX, pParallel->columns);
+  bool ctxOk = (0 != rowLen);
+
+  mtx_lock(&pParallel->lock);
+  while (!pParallel->abort && (pParallel->nextBlock < pParallel->blocks))
+  {
+    size_t block = pParallel->nextBlock;
+    if (block >= (pParallel->delivered + pParallel->slots))
+    {
+      cnd_wait(&pParallel->changed, &pParallel->lock); // all buffers in use
+      continue;
+    }
+    pParallel->nextBlock++;
+    mtx_unlock(&pParallel->lock);
+
+    T_Block* pBlock = &pParallel->pSlots[block % pParallel->slots];
+    if (ctxOk && (0 == pBlock->size))
+    {
+      // one row length per row and a text and a grid line per row are enough for most blocks,
+      // the buffers are reused for the following blocks
+      size_t lines = ((pParallel->blockRows < pParallel->rows) ? pParallel->blockRows : pParallel->rows) + 3;
+      ctxOk = TextTableCtxReserve(&pBlock->buf, &pBlock->size, rowLen * lines, 1) &&
+              TextTableCtxReserve(&pBlock->lens, &pBlock->linesCap, lines * 2, sizeof(*pBlock->lens));
+    }
+    size_t firstRow = block * pParallel->blockRows;
+    size_t lastRow = ((pParallel->rows - firstRow) > pParallel->blockRows) ? (firstRow + pParallel->blockRows) :
+                     pParallel->rows;
+    bool ok = ctxOk && TextTableRenderBlock(pParallel->table, &ctx, pBlock, pParallel->tabStyle, pParallel->posX,
+                                            pParallel->columns, firstRow, lastRow, pParallel->rows);
+
+    mtx_lock(&pParallel->lock);
+    pBlock->block = block;
+    pBlock->ok = ok;
+    pBlock->done = true;
+    cnd_broadcast(&pParallel->changed);
+  }
+  mtx_unlock(&pParallel->lock);
+  TextTableRenderCtxFree(&ctx);
+  return 0;
+}
+#endif
+
+/**
+ * @brief         Print the table in batches of lines to the output callback function, the rows are rendered
+ *                by several threads. The rows are split into blocks of `blockRows` rows, the worker threads render
+ *                the blocks into their own buffers and the calling thread passes the lines to the callback function
+ *                in order, so the output is exactly the one of @ref TextTablePrintBatch(). A batch holds at most
+ *                @ref TEXT_TABLE_BATCH_LINES lines of one block.
+ *                Without C11 threads (`__STDC_NO_THREADS__`), with one thread or one block the table is printed
+ *                by @ref TextTablePrintBatch().
+ * @retval true   success
+ * @retval false  failed
+ * @ingroup       group_InterfaceFunctions
+ */
+bool TextTablePrintParallel(
+  const TextTable_t* table,                       ///< [in] The table.
+  TextTableLinesCallback_t LinesCallbackFunction, ///< [in] Function pointer to output function.
+  void* context,                                  ///< [in] Passed to the output function.
+  TabStyle_e tabStyle,                            ///< [in] Choose one of the styles.
+  size_t posX,                                    ///< [in] Number of chars to right shift the table.
+  size_t columns,                                 ///< [in] Number of table columns, 0 = declared columns.
+  size_t threads,                                 ///< [in] Number of worker threads, 0 and 1 = serial
+  size_t blockRows)                               ///< [in] Number of table rows per block,
+                                                  /// 0 = @ref TEXT_TABLE_PARALLEL_BLOCK_ROWS
+{
+#ifndef __STDC_NO_THREADS__
+  if (0 == blockRows)
+  {
+    blockRows = TEXT_TABLE_PARALLEL_BLOCK_ROWS;
+  }
+  size_t rows = (1 < threads) ? TextTableRows(table, posX, &columns) : 0;
+  if ((NULL != LinesCallbackFunction) && (blockRows < rows))
+  {
+    T_Parallel parallel;
+    memset(&parallel, 0, sizeof(parallel));
+    parallel.table = table;
+    parallel.tabStyle = tabStyle;
+    parallel.posX = posX;
+    parallel.columns = columns;
+    parallel.rows = rows;
+    parallel.blockRows = blockRows;
+    parallel.blocks = (rows + blockRows - 1) / blockRows;
+    thrd_t worker[TEXT_TABLE_PARALLEL_MAX_THREADS];
+    size_t workers = 0;
+    if (threads > TEXT_TABLE_PARALLEL_MAX_THREADS)
+    {
+      threads = TEXT_TABLE_PARALLEL_MAX_THREADS;
+    }
+    parallel.slots = threads * 2;
+    parallel.pSlots = (T_Block*)calloc(parallel.slots, sizeof(T_Block));
+    if (NULL == parallel.pSlots)
+    {
+      return false;
+    }
+    if (thrd_success != mtx_init(&parallel.lock, mtx_plain))
+    {
+      free(parallel.pSlots);
+      return false;
+    }
+    if (thrd_success != cnd_init(&parallel.changed))
+    {
+      mtx_destroy(&parallel.lock);
+      free(parallel.pSlots);
+      return false;
+    }
+    while ((workers < threads) &&
+           (thrd_success == thrd_create(&worker[workers], TextTableParallelWorker, &parallel)))
+    {
+      workers++;
+    }
+
+    // deliver the blocks in order
+    bool ok = (0 != workers);
+    for (size_t block = 0; ok && (block < parallel.blocks); block++)
+    {
+      T_Block* pBlock = &parallel.pSlots[block % parallel.slots];
+      mtx_lock(&parallel.lock);
+      while (!pBlock->done || (pBlock->block != block))
+      {
+        cnd_wait(&parallel.changed, &parallel.lock);
+      }
+      mtx_unlock(&parallel.lock);
+
+      ok = pBlock->ok;
+      if (ok)
+      {
+        TextTableBlockDeliver(pBlock, LinesCallbackFunction, context);
+      }
+
+      mtx_lock(&parallel.lock);
+      pBlock->done = false;
+      parallel.delivered++;
+      parallel.abort = !ok;
+      cnd_broadcast(&parallel.changed);
+      mtx_unlock(&parallel.lock);
+    }
+
+    mtx_lock(&parallel.lock);
+    parallel.abort = true;
+    cnd_broadcast(&parallel.changed);
+    mtx_unlock(&parallel.lock);
+    for (size_t i = 0; i < workers; i++)
+    {
+      thrd_join(worker[i], NULL);
+    }
+    cnd_destroy(&parallel.changed);
+    mtx_destroy(&parallel.lock);
+    for (size_t i = 0; i < parallel.slots; i++)
+    {
+      free(parallel.pSlots[i].buf);
+      free(parallel.pSlots[i].lens);
+    }
+    free(parallel.pSlots);
+    return ok;
+  }
+#else
+  (void)threads;
+  (void)blockRows;
+#endif
+
+  return TextTablePrintBatch(table, NULL, LinesCallbackFunction, context, tabStyle, posX, columns);
+}
+
+/**
+ * @brief         Start streaming the table.
+ *                Each row is printed as soon as its last column is added and released afterwards, only the
+ *                header (first table row) is kept. The memory of the table does not grow with the number of rows.
+ *                - With `widths` the column widths are fixed from the beginning
+ *                - Without `widths` the first `sampleRows` rows are buffered and printed together, the column
+ *                  widths of these rows are used for the rest of the table
+ *                - Longer texts of later rows are truncated to the column width
+ *                - @ref TextTableStreamEnd() prints the closing line, @ref TextTableFree() releases the table
+ * @retval true   success
+ * @retval false  failed - invalid arguments, the table is not empty or no memory
+ * @ingroup       group_InterfaceFunctions
+ */
+bool TextTableStreamBegin(
+  TextTable_t* table,                                 ///< [in] The table, initialized but empty.
+  TextTableStream_t* stream,                          ///< [in] Stream state, must stay valid until @ref TextTableStreamEnd().
+  void(*PrintLineCallbackFunction)(const char* line), ///< [in] Function pointer to output function.
+  TabStyle_e tabStyle,                                ///< [in] Choose one of the styles.
+  size_t posX,                                        ///< [in] Number of chars to right shift the table.
+  size_t columns,                                     ///< [in] Number of table columns.
+  const size_t* widths,                               ///< [in] Text width of each column or NULL.
+  size_t sampleRows)                                  ///< [in] Number of rows to sample the widths if `widths` is NULL.
+{
+  if ((NULL == table) || (NULL == stream) || (NULL == PrintLineCallbackFunction) || (0 == columns) ||
+      (posX > TEXT_TABLE_MAX_X_POS) || (0 != table->entries) || (NULL != table->stream) ||
+      !TextTableCacheCreate(table))
+  {
+    return false;
+  }
+  TextTableLayout_t* pLayout = table->layout;
+  if (!TextTableCtxReserve(&pLayout->columns, &pLayout->columnsCap, columns, sizeof(T_Column)))
+  {
+    return false;
+  }
+  T_Column* pColumn = (T_Column*)pLayout->columns;
+  memset(pColumn, 0, sizeof(T_Column) * columns);
+  free(pLayout->widthCount); // rows are released, cells cannot be changed
+  pLayout->widthCount = NULL;
+  pLayout->columnCount = columns;
+  pLayout->entries = 0;
+  pLayout->gridLen = 0;
+  pLayout->fixed = (NULL != widths);
+  for (size_t i = 0; pLayout->fixed && (i < columns); i++)
+  {
+    pColumn[i].rowMaxTextLen = (0 == widths[i]) ? 1 : widths[i];
+    if (TEXT_TABLE_MAX_COLUMN_LEN < pColumn[i].rowMaxTextLen)
     {
-      gridBuf[idx] = table->charGridX;
-      headBuf[idx] = table->charHeadX;
-      idx++;
+      pColumn[i].rowMaxTextLen = TEXT_TABLE_MAX_COLUMN_LEN;
     }
-    gridBuf[idx] = table->charConnectorXY;
-    headBuf[idx] = table->charConnectorXY;
-    idx++;
   }
-  gridBuf[idx] = '\0';
-  headBuf[idx] = '\0';
+  // row buffer for any ANSI sequences and multibyte characters
+  pLayout->ansiMaxLen = pLayout->fixed ? TEXT_TABLE_FIXED_ANSI_LEN(columns) : 0;
+  pLayout->ansiRowLen = 0;
+  pLayout->utf8MaxLen = pLayout->fixed ? TEXT_TABLE_FIXED_UTF8_LEN(columns) : 0;
+  pLayout->utf8RowLen = 0;
+  table->columns = columns;
 
-  // print table
-  pEntry = table->head;
-  // rows
-  bool firstTableLine = true;
-  for (size_t i = 0; i < rows; i++)
+  stream->PrintLineCallbackFunction = PrintLineCallbackFunction;
+  TextTableRenderCtxInit(&stream->ctx);
+  stream->tabStyle = tabStyle;
+  stream->posX = posX;
+  stream->sampleRows = (0 == sampleRows) ? 1 : sampleRows;
+  stream->rows = 0;
+  stream->markChunk = NULL;
+  stream->markUsed = 0;
+  table->stream = stream;
+  return true;
+}
+
+/**
+ * @brief   Release all rows behind the header of a streamed table.
+ *          With arena the chunks are reset to the end of the header row.
+ */
+static void TextTableStreamRelease(TextTable_t* table) ///< [in] The table
+{
+  TextTableStream_t* pStream = table->stream;
+  TextTableCells_t* pCells = &table->cells;
+  if (0 == table->chunkSize)
   {
-    bool newLine = false;
-    bool firstRowPerColumn = true;
-    TextTableEntry_t* pEntrySave = pEntry;
-    // columns
-    do
+    for (size_t idx = table->columns; idx < table->entries; idx++)
     {
-      size_t idxRow = posX;
-      // if newline detected restore column pointer
-      if (newLine)
+      if (0 == (pCells->flags[idx] & TEXT_TABLE_CELL_BORROWED))
       {
-        pEntry = pEntrySave;
-        newLine = false;
+        free((void*)pCells->text[idx]);
       }
+      free((void*)TextTableRowStart(pCells, idx));
+    }
+  }
+  else
+  {
+    while (table->chunks != pStream->markChunk)
+    {
+      TextTableChunk_t* pChunkNext = table->chunks->nextChunk;
+      free(table->chunks);
+      table->chunks = pChunkNext;
+    }
+    if (NULL != pStream->markChunk)
+    {
+      pStream->markChunk->used = pStream->markUsed;
+    }
+  }
+  table->entries = table->columns;
+  table->layout->entries = table->entries;
+}
 
-      for (size_t j = 0; j < columns; j++)
-      {
-        if (0 == j) // first column in table
-        {
-          if (0 == i) // first row in table
-          {
-            switch (tabStyle)
-            {
-            case TABSTYLE_COMACT:
-              break;
-            case TABSTYLE_REGULAR_HEAD_OFF:
-            case TABSTYLE_SEPARATED_HEAD_OFF:
-              rowBuf[idxRow++] = table->charGridBoundary;
-              for (size_t spaces = 0; spaces < table->spacesBetweenBorder; spaces++)
-              {
-                rowBuf[idxRow++] = ' ';
-              }
-              break;
-            case TABSTYLE_REGULAR_HEAD_ON:
-            case TABSTYLE_SEPARATED_HEAD_ON:
-              rowBuf[idxRow++] = table->charHeadBoundary;
-              for (size_t spaces = 0; spaces < table->spacesBetweenBorder; spaces++)
-              {
-                rowBuf[idxRow++] = ' ';
-              }
-              break;
-            }
-          }
-          else        // next row, first column in table
-          {
-            if (TABSTYLE_COMACT != tabStyle)
-            {
-              rowBuf[idxRow++] = table->charGridBoundary;
-              for (size_t spaces = 0; spaces < table->spacesBetweenBorder; spaces++)
-              {
-                rowBuf[idxRow++] = ' ';
-              }
-            }
-          }
-        }
-        else
-        {
-          for (size_t spaces = 0; spaces < table->spacesBetweenBorder; spaces++)
-          {
-            rowBuf[idxRow++] = ' ';
-          }
-        }
+/**
+ * @brief   Print the complete rows of a streamed table which are not printed yet and release them.
+ * @retval true   success
+ * @retval false  failed - no memory
+ */
+static bool TextTableStreamPrint(
+  TextTable_t* table, ///< [in] The table
+  size_t rows)        ///< [in] Number of complete rows in the table
+{
+  TextTableStream_t* pStream = table->stream;
+  size_t firstRow = (0 == pStream->rows) ? 0 : 1;
+  uint8_t renderFlags = TEXT_TABLE_RENDER_OPEN;
+  if (0 != pStream->rows)
+  {
+    renderFlags |= TEXT_TABLE_RENDER_CONTINUE;
+  }
+  if (1 < pStream->rows)
+  {
+    renderFlags |= TEXT_TABLE_RENDER_SEPARATE;
+  }
 
-        if (firstRowPerColumn)
-        {
-          pEntry->writeTxt = pEntry->text; // set write pointer
-        }
-        // write column row
-        for (size_t k = 0; k < pColumn[j].rowMaxTextLen; k++)
-        {
-          // ansi sequence start
-          if ((0 == k) && (NULL != pEntry->ansiSeq))
-          {
-            memcpy(&rowBuf[idxRow], pEntry->ansiSeq, pEntry->ansiSeqLen);
-            idxRow = idxRow + pEntry->ansiSeqLen;
-          }
-          // space or text
-          if ((NULL == pEntry->writeTxt) || (0x00 == *pEntry->writeTxt) || ('\n' == *pEntry->writeTxt))
-          {
-            rowBuf[idxRow++] = ' '; // space
-          }
-          else
-          {
-            rowBuf[idxRow++] = *pEntry->writeTxt++;
-          }
-        }
+  bool ok = (0 != TextTableCtxPrepare(table, &pStream->ctx, pStream->posX, table->columns));
+  if (ok)
+  {
+    T_PrintContext context = {pStream->PrintLineCallbackFunction};
+    T_Sink sink = {TextTablePrintLine, &context};
+    ok = TextTableRenderLines(table, &pStream->ctx, &sink, pStream->tabStyle, pStream->posX, table->columns,
+                              firstRow, rows, renderFlags);
+    pStream->rows += rows - firstRow;
+  }
+  TextTableStreamRelease(table);
+  return ok;
+}
 
-        // ansi sequence end
-        if (NULL != pEntry->ansiSeq)
-        {
-          memcpy(&rowBuf[idxRow], sAnsiSequenceEnd, sizeof(sAnsiSequenceEnd));
-          idxRow = idxRow + sizeof(sAnsiSequenceEnd);
-        }
+/**
+ * @brief   Called for each completed row of a streamed table.
+ * @retval true   success
+ * @retval false  failed - no memory
+ */
+static bool TextTableStreamRows(TextTable_t* table) ///< [in] The table
+{
+  TextTableStream_t* pStream = table->stream;
+  TextTableLayout_t* pLayout = table->layout;
+  size_t rows = table->entries / table->columns;
+  if ((0 == pStream->rows) && (1 == rows))
+  {
+    // header complete, the arena memory behind it is released with each printed row
+    pStream->markChunk = table->chunks;
+    pStream->markUsed = (NULL == table->chunks) ? 0 : table->chunks->used;
+  }
+  if (!pLayout->fixed)
+  {
+    if (rows < pStream->sampleRows)
+    {
+      return true;
+    }
+    // sampled widths are used for the rest of the table
+    TextTableMeasure(table, pLayout, table->columns, pLayout->entries);
+    pLayout->ansiMaxLen = TEXT_TABLE_FIXED_ANSI_LEN(table->columns);
+    pLayout->utf8MaxLen = TEXT_TABLE_FIXED_UTF8_LEN(table->columns);
+    pLayout->entries = table->entries;
+    pLayout->fixed = true;
+    pLayout->gridLen = 0;
+  }
+  return TextTableStreamPrint(table, rows);
+}
 
-        // check if newline in column row - increase write pointer
-        if ((NULL != pEntry->writeTxt) && ('\n' == *pEntry->writeTxt))
-        {
-          newLine = true;
-          pEntry->writeTxt++;
-        }
+/**
+ * @brief         Finish streaming the table.
+ *                Buffered rows are printed and the closing line is added. An incomplete last row is not printed.
+ *                The table keeps the header and continues as a table with declared columns: the column widths
+ *                are measured again from the kept entries, fixed or sampled widths of the stream are dropped.
+ * @retval true   success
+ * @retval false  failed - no active stream, incomplete last row or no memory
+ * @ingroup       group_InterfaceFunctions
+ */
+bool TextTableStreamEnd(TextTable_t* table) ///< [in] The table
+{
+  if ((NULL == table) || (NULL == table->stream))
+  {
+    return false;
+  }
+  TextTableStream_t* pStream = table->stream;
+  bool ok = (0 == (table->entries % table->columns));
+  size_t rows = table->entries / table->columns;
+  if (!table->layout->fixed && (0 != rows))
+  {
+    // less rows than sampled
+    ok = TextTableStreamPrint(table, rows) && ok;
+  }
+  if ((0 != pStream->rows) && (TABSTYLE_COMACT != pStream->tabStyle))
+  {
+    pStream->PrintLineCallbackFunction(table->layout->gridBuf);
+  }
+  TextTableRenderCtxFree(&pStream->ctx);
+  table->stream = NULL;
 
-        for (size_t spaces = 0; spaces < table->spacesBetweenBorder; spaces++)
-        {
-          rowBuf[idxRow++] = ' ';
-        }
-        if (TABSTYLE_COMACT != tabStyle)
-        {
-          if (j < (columns - 1))
-          {
-            rowBuf[idxRow++] = table->charGridSeparator; // separate column
-          }
-        }
+  // the kept rows continue as a table with declared columns, the widths of the stream do not apply any more
+  return TextTableLayoutCount(table, table->columns) && ok;
+}
 
-        pEntry = pEntry->nextEntry;
-      }
-      if (0 == i) // first row, last column in table
-      {
-        switch (tabStyle)
-        {
-        case TABSTYLE_COMACT:
-          break;
-        case TABSTYLE_REGULAR_HEAD_OFF:
-        case TABSTYLE_SEPARATED_HEAD_OFF:
-          rowBuf[idxRow++] = table->charGridBoundary;
-          break;
-        case TABSTYLE_REGULAR_HEAD_ON:
-        case TABSTYLE_SEPARATED_HEAD_ON:
-          rowBuf[idxRow++] = table->charHeadBoundary;
-          break;
-        }
-      }
-      else // next row, last column in table
-      {
-        if (TABSTYLE_COMACT != tabStyle)
-        {
-          rowBuf[idxRow++] = table->charGridBoundary;
-        }
-      }
-      rowBuf[idxRow] = 0x00; // zero terminated
+/**
+ * @brief   Remove all entries, the cell arrays and the layout buffers are kept for the next entries.
+ *          With arena only the chunks are released, the entries are not walked.
+ */
+static void TextTableClear(TextTable_t* table) ///< [in] the table
+{
+  TextTableChunk_t* pChunk = table->chunks;
+  while (NULL != pChunk)
+  {
+    TextTableChunk_t* pChunkNext = pChunk->nextChunk;
+    free(pChunk);
+    pChunk = pChunkNext;
+  }
+  table->chunks = NULL;
 
-      // first line
-      if (firstTableLine)
+  // without arena each text and row index has its own allocation
+  TextTableCells_t* pCells = &table->cells;
+  if (0 == table->chunkSize)
+  {
+    for (size_t idx = 0; idx < table->entries; idx++)
+    {
+      if (0 == (pCells->flags[idx] & TEXT_TABLE_CELL_BORROWED))
       {
-        switch (tabStyle)
-        {
-        case TABSTYLE_COMACT:
-          break;
-        case TABSTYLE_REGULAR_HEAD_OFF:
-        case TABSTYLE_SEPARATED_HEAD_OFF:
-          PrintLineCallbackFunction(gridBuf);
-          break;
-        case TABSTYLE_REGULAR_HEAD_ON:
-        case TABSTYLE_SEPARATED_HEAD_ON:
-          PrintLineCallbackFunction(headBuf);
-          break;
-        }
+        free((void*)pCells->text[idx]);
       }
-      PrintLineCallbackFunction(rowBuf);
-      firstTableLine = false;
-      firstRowPerColumn = false;
+      free((void*)TextTableRowStart(pCells, idx));
+    }
+  }
+  table->entries = 0;
+  if (NULL != table->layout)
+  {
+    TextTableLayoutReset(table->layout);
+  }
+}
 
+/**
+ * @brief   Release all allocated memory.
+ *          With arena only the chunks are released, the entries are not walked.
+ * @ingroup group_InterfaceFunctions
+ */
+void TextTableFree(TextTable_t* table) ///< [in] the table
+{
+  if (NULL != table)
+  {
+    if (NULL != table->stream)
+    {
+      TextTableRenderCtxFree(&table->stream->ctx);
+      table->stream = NULL;
     }
-    while (newLine);
 
-    if (i == 0) // first row, closing line of header
+    TextTableClear(table);
+    TextTableCells_t* pCells = &table->cells;
+    free(pCells->text);
+    free(pCells->textLen);
+    free(pCells->textCap);
+    free(pCells->rowMaxTextLen);
+    free(pCells->styleId);
+    free(pCells->ansiSeqLen);
+    free(pCells->flags);
+    free(pCells->textRows);
+    free(pCells->rowStart);
+    memset(pCells, 0, sizeof(*pCells));
+    free(table->styles.seq);
+    free(table->styles.seqLen);
+    free(table->styles.flags);
+    memset(&table->styles, 0, sizeof(table->styles));
+
+    if (NULL != table->layout)
     {
-      switch (tabStyle)
-      {
-      case TABSTYLE_COMACT:
-      case TABSTYLE_REGULAR_HEAD_OFF:
-        // no closing line
-        break;
-      case TABSTYLE_SEPARATED_HEAD_OFF:
-        PrintLineCallbackFunction(gridBuf);
-        break;
-      case TABSTYLE_REGULAR_HEAD_ON:
-      case TABSTYLE_SEPARATED_HEAD_ON:
-        PrintLineCallbackFunction(headBuf);
-        break;
-      }
+      free(table->layout->columns);
+      free(table->layout->widthCount);
+      free(table->layout->gridBuf);
+      free(TextTableCache(table));
+      table->layout = NULL;
     }
-    else if (i < (rows - 1)) // between rows
+    table->columns = 0;
+  }
+}
+
+/**
+ * @brief         Initialize a snapshot for a table that is refreshed by one writer thread and printed by other threads.
+ *                The writer fills a back table (@ref TextTableSnapshotBegin()) and publishes it at once
+ *                (@ref TextTableSnapshotPublish()), the readers print the last published table
+ *                (@ref TextTableSnapshotAcquire(), @ref TextTableSnapshotRelease()).
+ *                Neither side takes a lock or waits: the readers count themselves per table and the writer only
+ *                reuses a table that is neither published nor read. The cell arrays of the tables are kept,
+ *                so a refresh with the same number of cells does not reallocate them.
+ * @retval true   success
+ * @retval false  failed
+ * @ingroup       group_InterfaceFunctions
+ */
+bool TextTableSnapshotInit(
+  TextTableSnapshot_t* snapshot,  ///< [in] The snapshot
+  size_t columns,                 ///< [in] Declared number of columns of each table, 0 = given at print time
+  size_t chunkSize)               ///< [in] Arena chunk size of each table, 0 = no arena
+{
+  if (NULL == snapshot)
+  {
+    return false;
+  }
+  snapshot->shared = (struct TextTableSnapshotShared_t*)malloc(sizeof(struct TextTableSnapshotShared_t));
+  if (NULL == snapshot->shared)
+  {
+    return false;
+  }
+  for (size_t i = 0; i < TEXT_TABLE_SNAPSHOT_TABLES; i++)
+  {
+    TextTable_t* table = &snapshot->tables[i];
+    bool ok = (0 == chunkSize) ? TextTableInit(table) : TextTableInitArena(table, chunkSize);
+    if (ok && (0 != columns))
     {
-      switch (tabStyle)
+      ok = TextTableInitColumns(table, columns);
+    }
+    snapshot->shared->readers[i] = 0;
+    if (!ok)
+    {
+      for (size_t j = 0; j <= i; j++)
       {
-      case TABSTYLE_COMACT:
-      case TABSTYLE_REGULAR_HEAD_ON:
-      case TABSTYLE_REGULAR_HEAD_OFF:
-        // no line
-        break;
-      case TABSTYLE_SEPARATED_HEAD_OFF:
-      case TABSTYLE_SEPARATED_HEAD_ON:
-        PrintLineCallbackFunction(gridBuf);
-        break;
+        TextTableFree(&snapshot->tables[j]);
       }
+      free(snapshot->shared);
+      snapshot->shared = NULL;
+      return false;
     }
   }
-  if (TABSTYLE_COMACT != tabStyle)
+  snapshot->shared->published = TEXT_TABLE_SNAPSHOT_TABLES;
+  snapshot->back = TEXT_TABLE_SNAPSHOT_TABLES;
+  return true;
+}
+
+/**
+ * @brief         Writer: get an empty back table to fill, a pending back table is cleared.
+ *                The cell texts of the last use of the table are released, the table memory is kept.
+ *                The writer does not wait for the readers: if every unpublished table is still printed, NULL is
+ *                returned at once and the published table stays valid. The writer can skip this refresh or try
+ *                again later, a table is free again as soon as its last reader releases it.
+ * @return        The back table or NULL - invalid argument or all unpublished tables are still printed
+ * @ingroup       group_InterfaceFunctions
+ */
+TextTable_t* TextTableSnapshotBegin(TextTableSnapshot_t* snapshot) ///< [in] The snapshot
+{
+  if ((NULL == snapshot) || (NULL == snapshot->shared))
   {
-    PrintLineCallbackFunction(gridBuf);
+    return NULL;
   }
+  size_t published = snapshot->shared->published;
+  size_t back = snapshot->back;
+  for (size_t i = 0; (TEXT_TABLE_SNAPSHOT_TABLES == back) && (i < TEXT_TABLE_SNAPSHOT_TABLES); i++)
+  {
+    if ((i != published) && (0 == snapshot->shared->readers[i]))
+    {
+      back = i;
+    }
+  }
+  if (TEXT_TABLE_SNAPSHOT_TABLES == back)
+  {
+    return NULL;
+  }
+  snapshot->back = back;
+  TextTableClear(&snapshot->tables[back]);
+  return &snapshot->tables[back];
+}
 
-  free(gridBuf);
-  free(headBuf);
-  free(rowBuf);
-  free(pColumn);
-
+/**
+ * @brief         Writer: publish the back table, the following @ref TextTableSnapshotAcquire() return it.
+ *                Readers of the previous table keep printing it until they release it.
+ * @retval true   success
+ * @retval false  failed - no back table, see @ref TextTableSnapshotBegin()
+ * @ingroup       group_InterfaceFunctions
+ */
+bool TextTableSnapshotPublish(TextTableSnapshot_t* snapshot) ///< [in] The snapshot
+{
+  if ((NULL == snapshot) || (NULL == snapshot->shared) || (TEXT_TABLE_SNAPSHOT_TABLES == snapshot->back))
+  {
+    return false;
+  }
+  snapshot->shared->published = snapshot->back;
+  snapshot->back = TEXT_TABLE_SNAPSHOT_TABLES;
   return true;
 }
 
 /**
- * @brief   Release all allocated memory.
- * @ingroup group_InterfaceFunctions
+ * @brief         Reader: get the last published table for printing, it stays valid until
+ *                @ref TextTableSnapshotRelease(). Several readers can print the same table at once.
+ * @return        The table or NULL if no table was published yet
+ * @ingroup       group_InterfaceFunctions
  */
-void TextTableFree(TextTable_t* table) ///< [in] the table
+const TextTable_t* TextTableSnapshotAcquire(TextTableSnapshot_t* snapshot) ///< [in] The snapshot
 {
-  if (NULL != table)
+  if ((NULL == snapshot) || (NULL == snapshot->shared))
+  {
+    return NULL;
+  }
+  struct TextTableSnapshotShared_t* pShared = snapshot->shared;
+  for (;;)
   {
-    TextTableEntry_t* pEntry = table->head;
-    while (NULL != pEntry)
+    size_t published = pShared->published;
+    if (TEXT_TABLE_SNAPSHOT_TABLES == published)
     {
-      TextTableEntry_t* pEntryNext = pEntry->nextEntry;
-      if (NULL != pEntry->text)
-      {
-        free(pEntry->text);
-      }
-      if (NULL != pEntry->ansiSeq)
-      {
-        free(pEntry->ansiSeq);
-      }
-      free(pEntry);
-      pEntry = pEntryNext;
+      return NULL;
     }
+    pShared->readers[published]++;
+    if (published == pShared->published)
+    {
+      return &snapshot->tables[published]; // still published, the writer cannot reuse it any more
+    }
+    pShared->readers[published]--; // the writer published a newer table meanwhile
+  }
+}
 
-    table->head = NULL;
-    table->tail = NULL;
-    table->entries = 0;
+/**
+ * @brief         Reader: release a table of @ref TextTableSnapshotAcquire(), the writer can reuse it afterwards.
+ * @ingroup       group_InterfaceFunctions
+ */
+void TextTableSnapshotRelease(
+  TextTableSnapshot_t* snapshot,  ///< [in] The snapshot
+  const TextTable_t* table)       ///< [in] The acquired table
+{
+  if ((NULL != snapshot) && (NULL != snapshot->shared) && (NULL != table))
+  {
+    snapshot->shared->readers[table - snapshot->tables]--;
+  }
+}
+
+/**
+ * @brief   Release all allocated memory of the snapshot, no table may be acquired any more.
+ * @ingroup group_InterfaceFunctions
+ */
+void TextTableSnapshotFree(TextTableSnapshot_t* snapshot) ///< [in] The snapshot
+{
+  if (NULL != snapshot)
+  {
+    for (size_t i = 0; i < TEXT_TABLE_SNAPSHOT_TABLES; i++)
+    {
+      TextTableFree(&snapshot->tables[i]);
+    }
+    free(snapshot->shared);
+    snapshot->shared = NULL;
+    snapshot->back = TEXT_TABLE_SNAPSHOT_TABLES;
   }
 }
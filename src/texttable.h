@@ -11,35 +11,107 @@
 #define _TEXT_TABLE_H_
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
 
 #define TEXT_TABLE_MAX_COLUMN_LEN       96  ///< Maximum text length of one column
 #define TEXT_TABLE_MAX_X_POS            30  ///< Maximum left shift of the whole table
 #define TEXT_TABLE_MAX_ANSI_SEQ_LEN     24  ///< Maximum length for ANSI sequence use
+#define TEXT_TABLE_MAX_STYLES           255 ///< Maximum number of different ANSI sequences per table
+#define TEXT_TABLE_ARENA_CHUNK_SIZE     (64 * 1024) ///< Default chunk size of the table arena
+#define TEXT_TABLE_PARALLEL_BLOCK_ROWS  1024  ///< Default number of table rows per block of TextTablePrintParallel()
+#define TEXT_TABLE_PARALLEL_MAX_THREADS 64    ///< Maximum number of worker threads of TextTablePrintParallel()
+#define TEXT_TABLE_SNAPSHOT_TABLES      3     ///< Number of tables of a snapshot, see TextTableSnapshotInit()
+#define TEXT_TABLE_BATCH_LINES          64    ///< Maximum number of lines per call of a TextTableLinesCallback_t
+#define TEXT_TABLE_BATCH_SIZE           (16 * 1024) ///< Size of the batch buffer, grows for longer lines
+#define TEXT_TABLE_ANSI_FULL            0     ///< Every styled cell is wrapped in its ANSI sequence and a reset
+#define TEXT_TABLE_ANSI_MINIMAL         1     ///< ANSI sequences only where the visible style changes
+#define TEXT_TABLE_ANSI_STRIP           2     ///< No ANSI sequences, e.g. for output to files and pipes
+
+#define TEXT_TABLE_CELL_BORROWED        0x01  ///< Cell flag: the text is owned by the caller (@ref TextTableAddRef())
+#define TEXT_TABLE_CELL_UTF8            0x02  ///< Cell flag: the text has multibyte characters, width is not length
 
  /**
-  * @brief   One table entry
+  * @brief   Cell storage of the table, one array per cell attribute (struct of arrays).
+  *          The cells are stored in the order they were added, so the cell of row `r` and column `c`
+  *          is found at index `r * columns + c`.
   */
-typedef struct TextTableEntry_t
+typedef struct
+{
+  const char** text;          ///< The text of each table cell or NULL (the length is given by textLen)
+  uint16_t* textLen;          ///< Length of each text
+  uint16_t* textCap;          ///< Size of the owned text buffer of each cell (without zero termination), 0 = none
+  uint16_t* rowMaxTextLen;    ///< Maximum display width of all rows in each cell
+  uint8_t* textRows;          ///< Number of rows (separated by `\n`) of each text
+  const uint8_t** rowStart;   ///< Start of each row of a text followed by the end of the printed text + 1,
+                              ///< NULL if the whole text is printed in one row (the array is NULL if no text needs it)
+  uint8_t* styleId;           ///< Style (ANSI sequence) of each cell, see @ref TextTableStyles_t, 0 = none
+  uint8_t* ansiSeqLen;        ///< Length of the ANSI sequence of each cell
+  uint8_t* flags;             ///< Flags of each cell, see @ref TEXT_TABLE_CELL_BORROWED
+  size_t capacity;            ///< Number of cells the arrays can hold
+}TextTableCells_t;
+
+/**
+ * @brief   One memory chunk of the table arena, the usable memory follows the header
+ */
+typedef struct TextTableChunk_t
 {
-  struct TextTableEntry_t* nextEntry; ///< Pointer to next table entry
-  struct TextTableEntry_t* prevEntry; ///< Pointer to previous table entry
-  char* text;                         ///< The text of the table cell
-  size_t textLen;                     ///< Length of the text
-  size_t rowMaxTextLen;               ///< Maximum text length of all rows in the table
-  char* ansiSeq;                      ///< Holds the ANSI sequence
-  size_t ansiSeqLen;                  ///< Length of the ANSI sequence
-  char* writeTxt;                     ///< Write pointer
-}TextTableEntry_t;
+  struct TextTableChunk_t* nextChunk; ///< Pointer to the previous allocated chunk or NULL
+  size_t size;                        ///< Usable size of the chunk
+  size_t used;                        ///< Bytes already handed out of the chunk
+}TextTableChunk_t;
+
+/**
+ * @brief   Cached column layout of the last print, reused as long as the column widths and the border do not change
+ */
+typedef struct
+{
+  void* columns;              ///< Width of each column (internal use)
+  size_t columnsCap;          ///< Number of columns the width array can hold
+  size_t columnCount;         ///< Number of columns of the layout, 0 = no layout
+  size_t entries;             ///< Number of entries included in the column widths
+  size_t* widthCount;         ///< Declared columns only: number of entries per text width
+  size_t ansiMaxLen;          ///< Most bytes of ANSI sequences and closing tags in one row (upper bound)
+  size_t ansiRowLen;          ///< Bytes of ANSI sequences and closing tags of the last measured row
+  size_t utf8MaxLen;          ///< Most bytes of multibyte characters beyond their display width in one row (upper bound)
+  size_t utf8RowLen;          ///< Bytes of multibyte characters beyond their display width of the last measured row
+  size_t rowLen;              ///< Length of the row buffer without right shift
+  char* gridBuf;              ///< Grid line followed by the head line
+  size_t gridBufSize;         ///< Size of one line in the grid buffer
+  size_t gridLen;             ///< Length of the grid and head line, 0 = lines must be rebuilt
+  bool fixed;                 ///< The column widths are fixed (streaming), longer texts are truncated
+  size_t gridPosX;            ///< Right shift of the cached lines
+  size_t gridSpaces;          ///< Spaces between border of the cached lines
+  char gridChars[3];          ///< charGridX, charHeadX and charConnectorXY of the cached lines
+}TextTableLayout_t;
+
+/**
+ * @brief   Style table: each different ANSI sequence of the table is stored once and referred to by its id,
+ *          the sequence of style `id` (1 ... @ref TEXT_TABLE_MAX_STYLES) starts at
+ *          `seq[(id - 1) * TEXT_TABLE_MAX_ANSI_SEQ_LEN]`.
+ */
+typedef struct
+{
+  char* seq;                  ///< The sequences of all styles, not zero terminated
+  uint8_t* seqLen;            ///< Length of each sequence
+  uint8_t* flags;             ///< Properties of each sequence, used by @ref TEXT_TABLE_ANSI_MINIMAL
+  size_t count;               ///< Number of styles
+  size_t capacity;            ///< Number of styles the arrays can hold
+}TextTableStyles_t;
 
 /**
  * @brief   The table
  */
 typedef struct
 {
-  TextTableEntry_t* head;     ///< Pointer to first entry or NULL
-  TextTableEntry_t* tail;     ///< Pointer to last entry or NULL
+  TextTableCells_t cells;     ///< The table cells
+  TextTableStyles_t styles;   ///< The ANSI sequences of the cells
   size_t entries;             ///< Number of table entries
+  TextTableChunk_t* chunks;   ///< Arena chunks, newest chunk first
+  size_t chunkSize;           ///< Arena chunk size, 0 = no arena (one allocation per entry)
+  TextTableLayout_t* layout;  ///< Cached column layout, allocated with its lock on the first change of the table
+  size_t columns;             ///< Declared number of columns, 0 = given at print time
+  struct TextTableStream_t* stream; ///< Active stream or NULL, see @ref TextTableStreamBegin()
 
   char charGridX;             ///< default '-'
   char charGridBoundary;      ///< default '|'
@@ -49,8 +121,38 @@ typedef struct
   char charHeadSeparator;     ///< default '|'
   char charConnectorXY;       ///< default '+'
   size_t spacesBetweenBorder; ///< Spaces (0x20) between column text and column border
+  uint8_t ansiMode;           ///< Output of the ANSI sequences, default @ref TEXT_TABLE_ANSI_FULL
 }TextTable_t;
 
+/**
+ * @brief   Reusable render buffers, see @ref TextTablePrintCtx().
+ *          The buffers only grow (high-water mark) and are released with @ref TextTableRenderCtxFree().
+ *          A print only reads the table, everything it writes is kept here: several threads can print
+ *          the same table at once, each with its own render context.
+ */
+typedef struct
+{
+  TextTableLayout_t layout;   ///< Copy of the table layout taken at the start of the print
+  char* lineBuf;              ///< Row line buffer followed by the line templates
+  size_t lineBufSize;         ///< Size of the line buffer
+  char* batchBuf;             ///< Lines of the current batch, see @ref TextTablePrintBatch()
+  size_t batchBufSize;        ///< Size of the batch buffer
+  const char* batchLines[TEXT_TABLE_BATCH_LINES]; ///< Start of each line of the current batch
+  size_t batchLens[TEXT_TABLE_BATCH_LINES];       ///< Length of each line of the current batch including `\n`
+}TextTableRenderCtx_t;
+
+/**
+ * @brief   Output callback function of @ref TextTablePrintBatch(), receives the lines in batches.
+ *          Each line ends with `\n` (included in the length) and is not zero terminated, the lines of one batch
+ *          are contiguous in memory: `lines[0]` with the sum of `lens` can be written at once, or `lines` and
+ *          `lens` are taken as `struct iovec` array for `writev()`. The lines are only valid during the call.
+ */
+typedef void(*TextTableLinesCallback_t)(
+  void* context,            ///< [in] Context pointer of the caller
+  const char* const* lines, ///< [in] Start of each line
+  const size_t* lens,       ///< [in] Length of each line including `\n`
+  size_t count);            ///< [in] Number of lines, at most @ref TEXT_TABLE_BATCH_LINES
+
 /**
  * @brief   Available table styles
  */
@@ -116,8 +218,36 @@ typedef enum TabStyle_e
 
 }TabStyle_e;
 
+/**
+ * @brief   State of a streamed table, see @ref TextTableStreamBegin()
+ */
+typedef struct TextTableStream_t
+{
+  void(*PrintLineCallbackFunction)(const char* line); ///< Output callback function
+  TextTableRenderCtx_t ctx;   ///< Render buffers
+  TabStyle_e tabStyle;        ///< Table style
+  size_t posX;                ///< Number of chars to right shift the table
+  size_t sampleRows;          ///< Number of rows buffered to sample the column widths
+  size_t rows;                ///< Number of rows already printed
+  TextTableChunk_t* markChunk;///< Arena chunk of the header row end
+  size_t markUsed;            ///< Used bytes of the arena chunk at the header row end
+}TextTableStream_t;
+
+/**
+ * @brief   Tables of a snapshot, one writer refreshes the table while other threads print it,
+ *          see @ref TextTableSnapshotInit()
+ */
+typedef struct
+{
+  TextTable_t tables[TEXT_TABLE_SNAPSHOT_TABLES]; ///< Published table, back table and a table still printed
+  struct TextTableSnapshotShared_t* shared;       ///< Reader counts and published table, shared by the threads (internal use)
+  size_t back;                                    ///< Index of the back table of the writer, `TEXT_TABLE_SNAPSHOT_TABLES` = none
+}TextTableSnapshot_t;
+
 
 bool TextTableInit(TextTable_t *table);
+bool TextTableInitArena(TextTable_t *table, size_t chunkSize);
+bool TextTableInitColumns(TextTable_t *table, size_t columns);
 // @cond make doxygen happy
 #ifdef _WIN32
 bool TextTableAdd(TextTable_t *table, const char *ansiSeq, const char* format, ...);
@@ -126,7 +256,38 @@ bool TextTableAdd(TextTable_t *table, const char *ansiSeq, const char* format, .
 #endif
 bool TextTableAdd(TextTable_t *table, const char *ansiSeq, const char* format, ...);
 // @endcond
-bool TextTablePrint(TextTable_t *table, void(*PrintLineCallbackFunction)(const char *line), TabStyle_e tabStyle, size_t posX, size_t columns);
+bool TextTableAddInt(TextTable_t *table, const char *ansiSeq, int64_t value);
+bool TextTableAddUInt(TextTable_t *table, const char *ansiSeq, uint64_t value);
+bool TextTableAddDouble(TextTable_t *table, const char *ansiSeq, double value, int precision);
+bool TextTableAddStr(TextTable_t *table, const char *ansiSeq, const char *text, size_t textLen);
+bool TextTableAddRef(TextTable_t *table, const char *ansiSeq, const char *text, size_t textLen);
+bool TextTableAppend(TextTable_t *table, TextTable_t *rows);
+// @cond make doxygen happy
+#ifdef _WIN32
+bool TextTableSet(TextTable_t *table, size_t row, size_t column, const char *ansiSeq, const char* format, ...);
+#else
+bool TextTableSet(TextTable_t *table, size_t row, size_t column, const char *ansiSeq, const char* format, ...)__attribute__((format(printf, 5, 6)));
+#endif
+bool TextTableSet(TextTable_t *table, size_t row, size_t column, const char *ansiSeq, const char* format, ...);
+// @endcond
+const char* TextTableGetText(const TextTable_t *table, size_t columns, size_t row, size_t column, size_t *textLen);
+bool TextTablePrint(const TextTable_t *table, void(*PrintLineCallbackFunction)(const char *line), TabStyle_e tabStyle, size_t posX, size_t columns);
+size_t TextTableRender(const TextTable_t *table, TabStyle_e tabStyle, size_t posX, size_t columns, char *buf, size_t cap, size_t *needed);
+bool TextTableRenderCtxInit(TextTableRenderCtx_t *ctx);
+bool TextTablePrintCtx(const TextTable_t *table, TextTableRenderCtx_t *ctx, void(*PrintLineCallbackFunction)(const char *line), TabStyle_e tabStyle, size_t posX, size_t columns);
+bool TextTablePrintRange(const TextTable_t *table, TextTableRenderCtx_t *ctx, void(*PrintLineCallbackFunction)(const char *line), TabStyle_e tabStyle, size_t posX, size_t columns, size_t firstRow, size_t lastRow, bool repeatHead);
+size_t TextTableRenderCtx(const TextTable_t *table, TextTableRenderCtx_t *ctx, TabStyle_e tabStyle, size_t posX, size_t columns, char *buf, size_t cap, size_t *needed);
+void TextTableRenderCtxFree(TextTableRenderCtx_t *ctx);
+bool TextTablePrintBatch(const TextTable_t *table, TextTableRenderCtx_t *ctx, TextTableLinesCallback_t LinesCallbackFunction, void *context, TabStyle_e tabStyle, size_t posX, size_t columns);
+bool TextTablePrintParallel(const TextTable_t *table, TextTableLinesCallback_t LinesCallbackFunction, void *context, TabStyle_e tabStyle, size_t posX, size_t columns, size_t threads, size_t blockRows);
+bool TextTableStreamBegin(TextTable_t *table, TextTableStream_t *stream, void(*PrintLineCallbackFunction)(const char *line), TabStyle_e tabStyle, size_t posX, size_t columns, const size_t *widths, size_t sampleRows);
+bool TextTableStreamEnd(TextTable_t *table);
 void TextTableFree(TextTable_t *table);
+bool TextTableSnapshotInit(TextTableSnapshot_t *snapshot, size_t columns, size_t chunkSize);
+TextTable_t* TextTableSnapshotBegin(TextTableSnapshot_t *snapshot);
+bool TextTableSnapshotPublish(TextTableSnapshot_t *snapshot);
+const TextTable_t* TextTableSnapshotAcquire(TextTableSnapshot_t *snapshot);
+void TextTableSnapshotRelease(TextTableSnapshot_t *snapshot, const TextTable_t *table);
+void TextTableSnapshotFree(TextTableSnapshot_t *snapshot);
 
 #endif
\ No newline at end of file
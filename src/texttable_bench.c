@@ -0,0 +1,1024 @@
+/**
+ * @file
+ * @author  kzachmann
+ * @date    2026-10-16 09:12
+ *
+ * @brief   Benchmarks of TextTable
+ *
+ * The heap functions are wrapped by the linker (`-Wl,--wrap=malloc` ..., see build_bench.sh),
+ * so every benchmark can report the number of allocations besides the run time.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <threads.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include "texttable.h"
+
+#define BENCH_COLUMNS   10      ///< Columns of the benchmark tables
+#define BENCH_ROWS      5000    ///< Rows of the benchmark tables
+#define BENCH_LOOPS     20      ///< Build/free cycles per measurement
+#define BENCH_BATCH     64      ///< Rows per append of the concurrent append benchmark
+#define BENCH_THREADS   16      ///< Maximum number of appending threads
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t nmemb, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+static atomic_size_t sAllocations = 0;   ///< Number of malloc/calloc/realloc calls, also from worker threads
+static atomic_size_t sFrees = 0;         ///< Number of free calls, also from worker threads
+
+/**
+ * @brief   Counting wrapper of `malloc()`
+ */
+void* __wrap_malloc(size_t size)
+{
+  sAllocations++;
+  return __real_malloc(size);
+}
+
+/**
+ * @brief   Counting wrapper of `calloc()`
+ */
+void* __wrap_calloc(size_t nmemb, size_t size)
+{
+  sAllocations++;
+  return __real_calloc(nmemb, size);
+}
+
+/**
+ * @brief   Counting wrapper of `realloc()`
+ */
+void* __wrap_realloc(void* ptr, size_t size)
+{
+  sAllocations++;
+  return __real_realloc(ptr, size);
+}
+
+/**
+ * @brief   Counting wrapper of `free()`
+ */
+void __wrap_free(void* ptr)
+{
+  if (NULL != ptr)
+  {
+    sFrees++;
+  }
+  __real_free(ptr);
+}
+
+/**
+ * @brief   Monotonic time in seconds
+ */
+static double BenchNow(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+static size_t sPrintBytes = 0;    ///< Bytes passed to the benchmark print callback
+
+/**
+ * @brief   Callback function for one line output
+ */
+static void PrintLineCallbackFunction(const char* line)
+{
+  printf("%s\n", line);
+}
+
+/**
+ * @brief   Callback function of the print benchmarks, only counts the bytes
+ */
+static void BenchLineCallbackFunction(const char* line)
+{
+  sPrintBytes += strlen(line) + 1;
+}
+
+/**
+ * @brief   Batch callback function of the parallel benchmark, only counts the bytes
+ */
+static void BenchLinesCallbackFunction(void* context, const char* const* lines, const size_t* lens, size_t count)
+{
+  (void)context;
+  (void)lines;
+  for (size_t i = 0; i < count; i++)
+  {
+    sPrintBytes += lens[i];
+  }
+}
+
+static int sNullFd = -1;          ///< `/dev/null`, output of the sink benchmarks
+
+/**
+ * @brief   Callback function of the sink benchmark, one `writev()` per line
+ */
+static void BenchWriteLineCallbackFunction(const char* line)
+{
+  struct iovec iov[2] = {{(void*)line, strlen(line)}, {"\n", 1}};
+  ssize_t written = writev(sNullFd, iov, 2);
+  sPrintBytes += (written > 0) ? (size_t)written : 0;
+}
+
+/**
+ * @brief   Batch callback function of the sink benchmark, one `writev()` per batch
+ */
+static void BenchWriteLinesCallbackFunction(void* context, const char* const* lines, const size_t* lens, size_t count)
+{
+  struct iovec iov[TEXT_TABLE_BATCH_LINES];
+  for (size_t i = 0; i < count; i++)
+  {
+    iov[i].iov_base = (void*)lines[i];
+    iov[i].iov_len = lens[i];
+  }
+  ssize_t written = writev(*(int*)context, iov, (int)count);
+  sPrintBytes += (written > 0) ? (size_t)written : 0;
+}
+
+/**
+ * @brief   Result of one benchmark
+ */
+typedef struct
+{
+  double seconds;       ///< Run time of all loops
+  size_t cells;         ///< Number of cells processed in all loops
+  size_t allocations;   ///< Allocations of all loops
+  size_t frees;         ///< Frees of all loops
+  size_t bytes;         ///< Output bytes of all loops
+}BenchResult_t;
+
+/**
+ * @brief   Add one row of the benchmark content, a status page like mix of text and numbers.
+ */
+static void BenchFillRow(TextTable_t* table, size_t i)
+{
+  TextTableAdd(table, NULL, "host-%04zu", i);
+  TextTableAdd(table, "\033[0;32m", "up");
+  TextTableAdd(table, NULL, "%zu", i * 17);
+  TextTableAdd(table, NULL, "%.2f", (double)i / 7.0);
+  TextTableAdd(table, NULL, "%zu ms", i % 1000);
+  TextTableAdd(table, NULL, "eth0\neth1");
+  TextTableAdd(table, NULL, "%08zx", i * 2654435761u);
+  TextTableAdd(table, "\033[0;33m", "warn %zu", i % 3);
+  TextTableAdd(table, NULL, "rack-%zu", i % 42);
+  TextTableAdd(table, NULL, "ok");
+}
+
+/**
+ * @brief   Fill the table with the benchmark content.
+ */
+static void BenchFill(TextTable_t* table)
+{
+  for (size_t i = 0; i < BENCH_ROWS; i++)
+  {
+    BenchFillRow(table, i);
+  }
+}
+
+/**
+ * @brief   State of one thread of @ref BenchAppend()
+ */
+typedef struct
+{
+  TextTable_t* table;   ///< The shared table
+  size_t firstRow;      ///< First benchmark row of the thread
+  size_t lastRow;       ///< End of the benchmark rows of the thread (exclusive)
+}BenchAppendThread_t;
+
+/**
+ * @brief   Thread of @ref BenchAppend(): fills its own arena table and appends it every `BENCH_BATCH` rows.
+ */
+static int BenchAppendThread(void* arg)
+{
+  BenchAppendThread_t* pThread = (BenchAppendThread_t*)arg;
+  TextTable_t tRows;
+  TextTableInitArena(&tRows, 0);
+  for (size_t i = pThread->firstRow; i < pThread->lastRow; i++)
+  {
+    BenchFillRow(&tRows, i);
+    if ((0 == ((i + 1 - pThread->firstRow) % BENCH_BATCH)) || ((i + 1) == pThread->lastRow))
+    {
+      TextTableAppend(pThread->table, &tRows);
+    }
+  }
+  TextTableFree(&tRows);
+  return 0;
+}
+
+/**
+ * @brief   Build the benchmark table with `threads` threads appending at once and free it, `BENCH_LOOPS` times.
+ */
+static BenchResult_t BenchAppend(
+  size_t threads) ///< [in] Number of appending threads, at most `BENCH_THREADS`
+{
+  BenchResult_t result;
+  BenchAppendThread_t appendThread[BENCH_THREADS];
+  thrd_t thread[BENCH_THREADS];
+  size_t allocations = sAllocations;
+  size_t frees = sFrees;
+  double start = BenchNow();
+  for (size_t loop = 0; loop < BENCH_LOOPS; loop++)
+  {
+    TextTable_t tTextTable;
+    TextTableInitArena(&tTextTable, 0);
+    TextTableInitColumns(&tTextTable, BENCH_COLUMNS);
+    for (size_t i = 0; i < threads; i++)
+    {
+      appendThread[i].table = &tTextTable;
+      appendThread[i].firstRow = (BENCH_ROWS * i) / threads;
+      appendThread[i].lastRow = (BENCH_ROWS * (i + 1)) / threads;
+      thrd_create(&thread[i], BenchAppendThread, &appendThread[i]);
+    }
+    for (size_t i = 0; i < threads; i++)
+    {
+      thrd_join(thread[i], NULL);
+    }
+    TextTableFree(&tTextTable);
+  }
+  result.seconds = BenchNow() - start;
+  result.cells = (size_t)BENCH_LOOPS * BENCH_ROWS * BENCH_COLUMNS;
+  result.allocations = sAllocations - allocations;
+  result.frees = sFrees - frees;
+  result.bytes = 0;
+  return result;
+}
+
+/**
+ * @brief   Build and free the benchmark table `BENCH_LOOPS` times.
+ */
+static BenchResult_t BenchBuildFree(
+  size_t chunkSize) ///< [in] 0 = heap mode, otherwise arena chunk size
+{
+  BenchResult_t result;
+  size_t allocations = sAllocations;
+  size_t frees = sFrees;
+  double start = BenchNow();
+  for (size_t loop = 0; loop < BENCH_LOOPS; loop++)
+  {
+    TextTable_t tTextTable;
+    if (0 == chunkSize)
+    {
+      TextTableInit(&tTextTable);
+    }
+    else
+    {
+      TextTableInitArena(&tTextTable, chunkSize);
+    }
+    BenchFill(&tTextTable);
+    TextTableFree(&tTextTable);
+  }
+  result.seconds = BenchNow() - start;
+  result.cells = (size_t)BENCH_LOOPS * BENCH_ROWS * BENCH_COLUMNS;
+  result.allocations = sAllocations - allocations;
+  result.frees = sFrees - frees;
+  result.bytes = 0;
+  return result;
+}
+
+/**
+ * @brief   Add `BENCH_ROWS * BENCH_COLUMNS` copies of one text `BENCH_LOOPS` times into an arena table,
+ *          the rate shows the cost of measuring the rows of a text.
+ */
+static BenchResult_t BenchAddText(
+  const char* text)   ///< [in] The text of each cell
+{
+  BenchResult_t result;
+  size_t textLen = strlen(text);
+  size_t allocations = sAllocations;
+  size_t frees = sFrees;
+  double start = BenchNow();
+  for (size_t loop = 0; loop < BENCH_LOOPS; loop++)
+  {
+    TextTable_t tTextTable;
+    TextTableInitArena(&tTextTable, 1024 * 1024);
+    for (size_t i = 0; i < (BENCH_ROWS * BENCH_COLUMNS); i++)
+    {
+      TextTableAddStr(&tTextTable, NULL, text, textLen);
+    }
+    TextTableFree(&tTextTable);
+  }
+  result.seconds = BenchNow() - start;
+  result.cells = (size_t)BENCH_LOOPS * BENCH_ROWS * BENCH_COLUMNS;
+  result.allocations = sAllocations - allocations;
+  result.frees = sFrees - frees;
+  result.bytes = 0;
+  return result;
+}
+
+/**
+ * @brief   Add `BENCH_ROWS * BENCH_COLUMNS` formatted cells `BENCH_LOOPS` times into an arena table.
+ */
+static BenchResult_t BenchFormat(
+  bool longFormat)  ///< [in] false = one short number, true = a long line with several conversions
+{
+  BenchResult_t result;
+  size_t allocations = sAllocations;
+  size_t frees = sFrees;
+  double start = BenchNow();
+  for (size_t loop = 0; loop < BENCH_LOOPS; loop++)
+  {
+    TextTable_t tTextTable;
+    TextTableInitArena(&tTextTable, 1024 * 1024);
+    for (size_t i = 0; i < (BENCH_ROWS * BENCH_COLUMNS); i++)
+    {
+      if (longFormat)
+      {
+        TextTableAdd(&tTextTable, NULL, "node %s/%zu: load %.3f, %zu requests, %s", "frankfurt-1", i, (double)i / 3.0, i * 7, "state nominal");
+      }
+      else
+      {
+        TextTableAdd(&tTextTable, NULL, "%zu", i);
+      }
+    }
+    TextTableFree(&tTextTable);
+  }
+  result.seconds = BenchNow() - start;
+  result.cells = (size_t)BENCH_LOOPS * BENCH_ROWS * BENCH_COLUMNS;
+  result.allocations = sAllocations - allocations;
+  result.frees = sFrees - frees;
+  result.bytes = 0;
+  return result;
+}
+
+/**
+ * @brief   Add integers, doubles and strings with the typed add functions or with the printf like @ref TextTableAdd().
+ */
+static BenchResult_t BenchTyped(
+  bool typed) ///< [in] true = TextTableAddInt() ..., false = TextTableAdd()
+{
+  static const char sName[] = "interned-hostname";
+  BenchResult_t result;
+  size_t allocations = sAllocations;
+  size_t frees = sFrees;
+  double start = BenchNow();
+  for (size_t loop = 0; loop < BENCH_LOOPS; loop++)
+  {
+    TextTable_t tTextTable;
+    TextTableInitArena(&tTextTable, 1024 * 1024);
+    for (size_t i = 0; i < ((BENCH_ROWS * BENCH_COLUMNS) / 4); i++)
+    {
+      int64_t value = ((int64_t)i * 7919) - 1000000;
+      double ratio = (double)i / 7.0;
+      if (typed)
+      {
+        TextTableAddInt(&tTextTable, NULL, value);
+        TextTableAddUInt(&tTextTable, NULL, (uint64_t)i * 2654435761u);
+        TextTableAddDouble(&tTextTable, NULL, ratio, 2);
+        TextTableAddStr(&tTextTable, NULL, sName, sizeof(sName) - 1);
+      }
+      else
+      {
+        TextTableAdd(&tTextTable, NULL, "%" PRId64, value);
+        TextTableAdd(&tTextTable, NULL, "%" PRIu64, (uint64_t)i * 2654435761u);
+        TextTableAdd(&tTextTable, NULL, "%.2f", ratio);
+        TextTableAdd(&tTextTable, NULL, "%s", sName);
+      }
+    }
+    TextTableFree(&tTextTable);
+  }
+  result.seconds = BenchNow() - start;
+  result.cells = (size_t)BENCH_LOOPS * ((BENCH_ROWS * BENCH_COLUMNS) / 4) * 4;
+  result.allocations = sAllocations - allocations;
+  result.frees = sFrees - frees;
+  result.bytes = 0;
+  return result;
+}
+
+/**
+ * @brief   Build a table of existing strings, copied with @ref TextTableAddStr() or borrowed with @ref TextTableAddRef().
+ */
+static BenchResult_t BenchExisting(
+  bool borrowed)  ///< [in] true = TextTableAddRef(), false = TextTableAddStr()
+{
+  static const char* const sNames[] = {"cpu.user", "cpu.system", "mem.used", "mem.cached", "net.rx_bytes",
+                                       "frontend-01.example.net", "frontend-02.example.net", "db-primary.example.net"};
+  static size_t sNamesLen[sizeof(sNames) / sizeof(sNames[0])];
+  for (size_t i = 0; i < (sizeof(sNames) / sizeof(sNames[0])); i++)
+  {
+    sNamesLen[i] = strlen(sNames[i]);
+  }
+
+  BenchResult_t result;
+  size_t allocations = sAllocations;
+  size_t frees = sFrees;
+  double start = BenchNow();
+  for (size_t loop = 0; loop < BENCH_LOOPS; loop++)
+  {
+    TextTable_t tTextTable;
+    TextTableInit(&tTextTable);
+    for (size_t i = 0; i < (BENCH_ROWS * BENCH_COLUMNS * 2); i++)
+    {
+      size_t name = i % (sizeof(sNames) / sizeof(sNames[0]));
+      if (borrowed)
+      {
+        TextTableAddRef(&tTextTable, NULL, sNames[name], sNamesLen[name]);
+      }
+      else
+      {
+        TextTableAddStr(&tTextTable, NULL, sNames[name], sNamesLen[name]);
+      }
+    }
+    TextTableFree(&tTextTable);
+  }
+  result.seconds = BenchNow() - start;
+  result.cells = (size_t)BENCH_LOOPS * BENCH_ROWS * BENCH_COLUMNS * 2;
+  result.allocations = sAllocations - allocations;
+  result.frees = sFrees - frees;
+  result.bytes = 0;
+  return result;
+}
+
+/**
+ * @brief   Stream the benchmark table `BENCH_LOOPS` times, each row is printed when it is complete.
+ */
+static BenchResult_t BenchStream(
+  size_t chunkSize) ///< [in] 0 = heap mode, otherwise arena chunk size
+{
+  static const size_t sWidths[BENCH_COLUMNS] = {9, 2, 5, 6, 6, 4, 8, 6, 7, 2};
+  BenchResult_t result;
+  size_t allocations = sAllocations;
+  size_t frees = sFrees;
+  sPrintBytes = 0;
+  double start = BenchNow();
+  for (size_t loop = 0; loop < BENCH_LOOPS; loop++)
+  {
+    TextTable_t tTextTable;
+    TextTableStream_t stream;
+    if (0 == chunkSize)
+    {
+      TextTableInit(&tTextTable);
+    }
+    else
+    {
+      TextTableInitArena(&tTextTable, chunkSize);
+    }
+    TextTableStreamBegin(&tTextTable, &stream, BenchLineCallbackFunction, TABSTYLE_REGULAR_HEAD_ON, 0, BENCH_COLUMNS,
+                         sWidths, 0);
+    BenchFill(&tTextTable);
+    TextTableStreamEnd(&tTextTable);
+    TextTableFree(&tTextTable);
+  }
+  result.seconds = BenchNow() - start;
+  result.cells = (size_t)BENCH_LOOPS * BENCH_ROWS * BENCH_COLUMNS;
+  result.allocations = sAllocations - allocations;
+  result.frees = sFrees - frees;
+  result.bytes = sPrintBytes;
+  return result;
+}
+
+/**
+ * @brief   Refresh the counters of the benchmark table `BENCH_LOOPS` times, either by building the whole
+ *          table again or by changing the 100 counter cells in place. The refreshed table is printed each time.
+ */
+static BenchResult_t BenchRefresh(
+  bool inPlace) ///< [in] true = @ref TextTableSet(), false = @ref TextTableFree() and build again
+{
+  BenchResult_t result;
+  TextTable_t tTextTable;
+  TextTableInitArena(&tTextTable, 0);
+  TextTableInitColumns(&tTextTable, BENCH_COLUMNS);
+  BenchFill(&tTextTable);
+
+  size_t allocations = sAllocations;
+  size_t frees = sFrees;
+  sPrintBytes = 0;
+  double start = BenchNow();
+  for (size_t loop = 0; loop < BENCH_LOOPS; loop++)
+  {
+    if (inPlace)
+    {
+      for (size_t row = 0; row < 100; row++)
+      {
+        TextTableSet(&tTextTable, row, 2, NULL, "%zu", (row * 17) + loop);
+      }
+    }
+    else
+    {
+      TextTableFree(&tTextTable);
+      TextTableInitArena(&tTextTable, 0);
+      TextTableInitColumns(&tTextTable, BENCH_COLUMNS);
+      BenchFill(&tTextTable);
+    }
+    TextTablePrint(&tTextTable, BenchLineCallbackFunction, TABSTYLE_REGULAR_HEAD_ON, 0, 0);
+  }
+  result.seconds = BenchNow() - start;
+  result.cells = (size_t)BENCH_LOOPS * BENCH_ROWS * BENCH_COLUMNS;
+  result.allocations = sAllocations - allocations;
+  result.frees = sFrees - frees;
+  result.bytes = sPrintBytes;
+
+  TextTableFree(&tTextTable);
+  return result;
+}
+
+/**
+ * @brief   Refresh the benchmark table `BENCH_LOOPS` times through a snapshot: build the back table, publish it,
+ *          acquire and print the published table.
+ */
+static BenchResult_t BenchSnapshot(void)
+{
+  BenchResult_t result;
+  TextTableSnapshot_t snapshot;
+  TextTableSnapshotInit(&snapshot, BENCH_COLUMNS, TEXT_TABLE_ARENA_CHUNK_SIZE);
+
+  size_t allocations = sAllocations;
+  size_t frees = sFrees;
+  sPrintBytes = 0;
+  double start = BenchNow();
+  for (size_t loop = 0; loop < BENCH_LOOPS; loop++)
+  {
+    BenchFill(TextTableSnapshotBegin(&snapshot));
+    TextTableSnapshotPublish(&snapshot);
+    const TextTable_t* table = TextTableSnapshotAcquire(&snapshot);
+    TextTablePrint(table, BenchLineCallbackFunction, TABSTYLE_REGULAR_HEAD_ON, 0, 0);
+    TextTableSnapshotRelease(&snapshot, table);
+  }
+  result.seconds = BenchNow() - start;
+  result.cells = (size_t)BENCH_LOOPS * BENCH_ROWS * BENCH_COLUMNS;
+  result.allocations = sAllocations - allocations;
+  result.frees = sFrees - frees;
+  result.bytes = sPrintBytes;
+
+  TextTableSnapshotFree(&snapshot);
+  return result;
+}
+
+/**
+ * @brief   Print the benchmark table `BENCH_LOOPS` times.
+ */
+static BenchResult_t BenchPrint(
+  TabStyle_e tabStyle,  ///< [in] Table style
+  bool reuseCtx)        ///< [in] true = print with one render context for all loops
+{
+  BenchResult_t result;
+  TextTable_t tTextTable;
+  TextTableRenderCtx_t ctx;
+  TextTableInit(&tTextTable);
+  TextTableRenderCtxInit(&ctx);
+  BenchFill(&tTextTable);
+  TextTablePrintCtx(&tTextTable, &ctx, BenchLineCallbackFunction, tabStyle, 0, BENCH_COLUMNS);
+
+  size_t allocations = sAllocations;
+  size_t frees = sFrees;
+  sPrintBytes = 0;
+  double start = BenchNow();
+  for (size_t loop = 0; loop < BENCH_LOOPS; loop++)
+  {
+    if (reuseCtx)
+    {
+      TextTablePrintCtx(&tTextTable, &ctx, BenchLineCallbackFunction, tabStyle, 0, BENCH_COLUMNS);
+    }
+    else
+    {
+      TextTablePrint(&tTextTable, BenchLineCallbackFunction, tabStyle, 0, BENCH_COLUMNS);
+    }
+  }
+  result.seconds = BenchNow() - start;
+  result.cells = (size_t)BENCH_LOOPS * BENCH_ROWS * BENCH_COLUMNS;
+  result.allocations = sAllocations - allocations;
+  result.frees = sFrees - frees;
+  result.bytes = sPrintBytes;
+
+  TextTableRenderCtxFree(&ctx);
+  TextTableFree(&tTextTable);
+  return result;
+}
+
+/**
+ * @brief   Print the benchmark table `BENCH_LOOPS` times to `/dev/null`, with one system call per line or per batch.
+ */
+static BenchResult_t BenchSink(
+  bool batch)   ///< [in] true = @ref TextTablePrintBatch(), false = @ref TextTablePrintCtx()
+{
+  BenchResult_t result;
+  TextTable_t tTextTable;
+  TextTableRenderCtx_t ctx;
+  TextTableInit(&tTextTable);
+  TextTableRenderCtxInit(&ctx);
+  BenchFill(&tTextTable);
+  sNullFd = open("/dev/null", O_WRONLY);
+  TextTablePrintBatch(&tTextTable, &ctx, BenchWriteLinesCallbackFunction, &sNullFd, TABSTYLE_REGULAR_HEAD_ON, 0,
+                      BENCH_COLUMNS);
+
+  size_t allocations = sAllocations;
+  size_t frees = sFrees;
+  sPrintBytes = 0;
+  double start = BenchNow();
+  for (size_t loop = 0; loop < BENCH_LOOPS; loop++)
+  {
+    if (batch)
+    {
+      TextTablePrintBatch(&tTextTable, &ctx, BenchWriteLinesCallbackFunction, &sNullFd, TABSTYLE_REGULAR_HEAD_ON, 0,
+                          BENCH_COLUMNS);
+    }
+    else
+    {
+      TextTablePrintCtx(&tTextTable, &ctx, BenchWriteLineCallbackFunction, TABSTYLE_REGULAR_HEAD_ON, 0, BENCH_COLUMNS);
+    }
+  }
+  result.seconds = BenchNow() - start;
+  result.cells = (size_t)BENCH_LOOPS * BENCH_ROWS * BENCH_COLUMNS;
+  result.allocations = sAllocations - allocations;
+  result.frees = sFrees - frees;
+  result.bytes = sPrintBytes;
+
+  close(sNullFd);
+  TextTableRenderCtxFree(&ctx);
+  TextTableFree(&tTextTable);
+  return result;
+}
+
+/**
+ * @brief   Print a colored table `BENCH_LOOPS` times with one render context, the output bytes show
+ *          the cost of the ANSI sequences.
+ */
+static BenchResult_t BenchAnsi(
+  uint8_t ansiMode,     ///< [in] Output of the ANSI sequences, e.g. @ref TEXT_TABLE_ANSI_STRIP
+  TabStyle_e tabStyle,  ///< [in] Table style
+  bool rowColors)       ///< [in] true = every cell colored by the state of its row, false = the benchmark content
+{
+  static const char* const sRowColors[] = {"\033[0;32m", "\033[0;32m", "\033[0;32m", "\033[0;33m", "\033[0;31m"};
+  BenchResult_t result;
+  TextTable_t tTextTable;
+  TextTableRenderCtx_t ctx;
+  TextTableInit(&tTextTable);
+  TextTableRenderCtxInit(&ctx);
+  tTextTable.ansiMode = ansiMode;
+  if (rowColors)
+  {
+    for (size_t i = 0; i < ((size_t)BENCH_ROWS * BENCH_COLUMNS); i++)
+    {
+      TextTableAdd(&tTextTable, sRowColors[(i / BENCH_COLUMNS) % 5], "%zu", i * 17);
+    }
+  }
+  else
+  {
+    BenchFill(&tTextTable);
+  }
+  TextTablePrintCtx(&tTextTable, &ctx, BenchLineCallbackFunction, tabStyle, 0, BENCH_COLUMNS);
+
+  size_t allocations = sAllocations;
+  size_t frees = sFrees;
+  sPrintBytes = 0;
+  double start = BenchNow();
+  for (size_t loop = 0; loop < BENCH_LOOPS; loop++)
+  {
+    TextTablePrintCtx(&tTextTable, &ctx, BenchLineCallbackFunction, tabStyle, 0, BENCH_COLUMNS);
+  }
+  result.seconds = BenchNow() - start;
+  result.cells = (size_t)BENCH_LOOPS * BENCH_ROWS * BENCH_COLUMNS;
+  result.allocations = sAllocations - allocations;
+  result.frees = sFrees - frees;
+  result.bytes = sPrintBytes;
+
+  TextTableRenderCtxFree(&ctx);
+  TextTableFree(&tTextTable);
+  return result;
+}
+
+static size_t sLineBufSize = 0;   ///< Row buffer of the last @ref BenchWideColored()
+
+/**
+ * @brief   Print a colored table of 100 columns `BENCH_LOOPS` times with one render context: every row highlights
+ *          one cell with a 24-bit color, every tenth column is red. The size of the row buffer is kept.
+ */
+static BenchResult_t BenchWideColored(void)
+{
+  BenchResult_t result;
+  TextTable_t tTextTable;
+  TextTableRenderCtx_t ctx;
+  TextTableInit(&tTextTable);
+  TextTableRenderCtxInit(&ctx);
+  size_t rows = ((size_t)BENCH_ROWS * BENCH_COLUMNS) / 100;
+  for (size_t i = 0; i < (rows * 100); i++)
+  {
+    const char* ansiSeq = ((i % 100) == ((i / 100) % 100)) ? "\033[38;2;255;128;0m" :
+                          ((0 == (i % 10)) ? "\033[31m" : NULL);
+    TextTableAdd(&tTextTable, ansiSeq, "%zu", i % 1000);
+  }
+  TextTablePrintCtx(&tTextTable, &ctx, BenchLineCallbackFunction, TABSTYLE_REGULAR_HEAD_ON, 0, 100);
+
+  size_t allocations = sAllocations;
+  size_t frees = sFrees;
+  sPrintBytes = 0;
+  double start = BenchNow();
+  for (size_t loop = 0; loop < BENCH_LOOPS; loop++)
+  {
+    TextTablePrintCtx(&tTextTable, &ctx, BenchLineCallbackFunction, TABSTYLE_REGULAR_HEAD_ON, 0, 100);
+  }
+  result.seconds = BenchNow() - start;
+  result.cells = (size_t)BENCH_LOOPS * rows * 100;
+  result.allocations = sAllocations - allocations;
+  result.frees = sFrees - frees;
+  result.bytes = sPrintBytes;
+  sLineBufSize = ctx.lineBufSize;
+
+  TextTableRenderCtxFree(&ctx);
+  TextTableFree(&tTextTable);
+  return result;
+}
+
+/**
+ * @brief   Print the benchmark table `BENCH_LOOPS` times with @ref TextTablePrintParallel().
+ */
+static BenchResult_t BenchPrintParallel(
+  size_t threads)   ///< [in] Number of worker threads
+{
+  BenchResult_t result;
+  TextTable_t tTextTable;
+  TextTableInit(&tTextTable);
+  BenchFill(&tTextTable);
+  TextTablePrintParallel(&tTextTable, BenchLinesCallbackFunction, NULL, TABSTYLE_REGULAR_HEAD_ON, 0, BENCH_COLUMNS,
+                         threads, 0);
+
+  size_t allocations = sAllocations;
+  size_t frees = sFrees;
+  sPrintBytes = 0;
+  double start = BenchNow();
+  for (size_t loop = 0; loop < BENCH_LOOPS; loop++)
+  {
+    TextTablePrintParallel(&tTextTable, BenchLinesCallbackFunction, NULL, TABSTYLE_REGULAR_HEAD_ON, 0,
+                           BENCH_COLUMNS, threads, 0);
+  }
+  result.seconds = BenchNow() - start;
+  result.cells = (size_t)BENCH_LOOPS * BENCH_ROWS * BENCH_COLUMNS;
+  result.allocations = sAllocations - allocations;
+  result.frees = sFrees - frees;
+  result.bytes = sPrintBytes;
+
+  TextTableFree(&tTextTable);
+  return result;
+}
+
+/**
+ * @brief   Build the benchmark table in an arena, print it once and free it, `BENCH_LOOPS` times.
+ */
+static BenchResult_t BenchBuildPrint(
+  bool declareColumns)  ///< [in] true = declare the columns, the widths are maintained while adding
+{
+  BenchResult_t result;
+  size_t allocations = sAllocations;
+  size_t frees = sFrees;
+  sPrintBytes = 0;
+  double start = BenchNow();
+  for (size_t loop = 0; loop < BENCH_LOOPS; loop++)
+  {
+    TextTable_t tTextTable;
+    TextTableInitArena(&tTextTable, 0);
+    if (declareColumns)
+    {
+      TextTableInitColumns(&tTextTable, BENCH_COLUMNS);
+    }
+    BenchFill(&tTextTable);
+    TextTablePrint(&tTextTable, BenchLineCallbackFunction, TABSTYLE_REGULAR_HEAD_ON, 0, BENCH_COLUMNS);
+    TextTableFree(&tTextTable);
+  }
+  result.seconds = BenchNow() - start;
+  result.cells = (size_t)BENCH_LOOPS * BENCH_ROWS * BENCH_COLUMNS;
+  result.allocations = sAllocations - allocations;
+  result.frees = sFrees - frees;
+  result.bytes = sPrintBytes;
+  return result;
+}
+
+/**
+ * @brief   Print a table of `BENCH_ROWS * BENCH_COLUMNS` cells with `columns` columns `BENCH_LOOPS` times
+ *          with one render context, the output rate shows the cost per line byte.
+ */
+static BenchResult_t BenchPrintShape(
+  size_t columns,   ///< [in] Number of columns
+  size_t cellLen,   ///< [in] Text length of each row of a cell
+  size_t cellRows)  ///< [in] Number of rows of each cell
+{
+  static const char sText[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+  char text[TEXT_TABLE_MAX_COLUMN_LEN];
+  BenchResult_t result;
+  TextTable_t tTextTable;
+  TextTableRenderCtx_t ctx;
+  TextTableInitArena(&tTextTable, 0);
+  TextTableRenderCtxInit(&ctx);
+  for (size_t cell = 0; cell < ((size_t)BENCH_ROWS * BENCH_COLUMNS); cell++)
+  {
+    size_t textLen = 0;
+    for (size_t row = 0; row < cellRows; row++)
+    {
+      if (0 != row)
+      {
+        text[textLen++] = '\n';
+      }
+      memcpy(&text[textLen], &sText[(cell + row) % 8], cellLen - ((cell + row) % 3));
+      textLen += cellLen - ((cell + row) % 3);
+    }
+    TextTableAddStr(&tTextTable, NULL, text, textLen);
+  }
+  TextTablePrintCtx(&tTextTable, &ctx, BenchLineCallbackFunction, TABSTYLE_SEPARATED_HEAD_ON, 0, columns);
+
+  size_t allocations = sAllocations;
+  size_t frees = sFrees;
+  sPrintBytes = 0;
+  double start = BenchNow();
+  for (size_t loop = 0; loop < BENCH_LOOPS; loop++)
+  {
+    TextTablePrintCtx(&tTextTable, &ctx, BenchLineCallbackFunction, TABSTYLE_SEPARATED_HEAD_ON, 0, columns);
+  }
+  result.seconds = BenchNow() - start;
+  result.cells = (size_t)BENCH_LOOPS * BENCH_ROWS * BENCH_COLUMNS;
+  result.allocations = sAllocations - allocations;
+  result.frees = sFrees - frees;
+  result.bytes = sPrintBytes;
+
+  TextTableRenderCtxFree(&ctx);
+  TextTableFree(&tTextTable);
+  return result;
+}
+
+/**
+ * @brief   Scroll through the benchmark table in pages of 50 rows with repeated header, `BENCH_LOOPS` times.
+ */
+static BenchResult_t BenchPages(void)
+{
+  BenchResult_t result;
+  TextTable_t tTextTable;
+  TextTableRenderCtx_t ctx;
+  TextTableInit(&tTextTable);
+  TextTableRenderCtxInit(&ctx);
+  BenchFill(&tTextTable);
+
+  size_t allocations = sAllocations;
+  size_t frees = sFrees;
+  sPrintBytes = 0;
+  double start = BenchNow();
+  for (size_t loop = 0; loop < BENCH_LOOPS; loop++)
+  {
+    for (size_t row = 1; row < BENCH_ROWS; row += 50)
+    {
+      size_t lastRow = ((row + 50) < BENCH_ROWS) ? (row + 50) : BENCH_ROWS;
+      TextTablePrintRange(&tTextTable, &ctx, BenchLineCallbackFunction, TABSTYLE_REGULAR_HEAD_ON, 0, BENCH_COLUMNS,
+                          row, lastRow, true);
+    }
+  }
+  result.seconds = BenchNow() - start;
+  result.cells = (size_t)BENCH_LOOPS * BENCH_ROWS * BENCH_COLUMNS;
+  result.allocations = sAllocations - allocations;
+  result.frees = sFrees - frees;
+  result.bytes = sPrintBytes;
+
+  TextTableRenderCtxFree(&ctx);
+  TextTableFree(&tTextTable);
+  return result;
+}
+
+/**
+ * @brief   Add one result row to the report table.
+ */
+static void BenchReport(TextTable_t* report, const char* name, BenchResult_t result)
+{
+  TextTableAdd(report, NULL, "%s", name);
+  TextTableAdd(report, NULL, "%.0f", (double)result.cells / result.seconds);
+  TextTableAdd(report, NULL, "%.2f", (double)result.allocations / (double)result.cells);
+  TextTableAdd(report, NULL, "%zu", result.allocations);
+  TextTableAdd(report, NULL, "%zu", result.frees);
+}
+
+/**
+ * @brief   Render the benchmark table `BENCH_LOOPS` times into one buffer.
+ */
+static BenchResult_t BenchRender(
+  TabStyle_e tabStyle)  ///< [in] Table style
+{
+  BenchResult_t result;
+  TextTable_t tTextTable;
+  TextTableInit(&tTextTable);
+  BenchFill(&tTextTable);
+  size_t needed = 0;
+  TextTableRender(&tTextTable, tabStyle, 0, BENCH_COLUMNS, NULL, 0, &needed);
+  char* buf = (char*)malloc(needed);
+
+  size_t allocations = sAllocations;
+  size_t frees = sFrees;
+  result.bytes = 0;
+  double start = BenchNow();
+  for (size_t loop = 0; loop < BENCH_LOOPS; loop++)
+  {
+    result.bytes += TextTableRender(&tTextTable, tabStyle, 0, BENCH_COLUMNS, buf, needed, NULL);
+  }
+  result.seconds = BenchNow() - start;
+  result.cells = (size_t)BENCH_LOOPS * BENCH_ROWS * BENCH_COLUMNS;
+  result.allocations = sAllocations - allocations;
+  result.frees = sFrees - frees;
+
+  free(buf);
+  TextTableFree(&tTextTable);
+  return result;
+}
+
+/**
+ * @brief   Add one print result row to the report table.
+ */
+static void BenchReportPrint(TextTable_t* report, const char* name, BenchResult_t result)
+{
+  TextTableAdd(report, NULL, "%s", name);
+  TextTableAdd(report, NULL, "%.0f", (double)result.cells / result.seconds);
+  TextTableAdd(report, NULL, "%.1f", ((double)result.bytes / result.seconds) / (1024.0 * 1024.0));
+  TextTableAdd(report, NULL, "%.1f", (double)result.bytes / (double)result.cells);
+  TextTableAdd(report, NULL, "%zu", result.allocations);
+}
+
+/**
+ * @brief   main
+ */
+int main(int argc, char* argv[])
+{
+  (void)argc;
+  (void)argv;
+
+  TextTable_t report;
+  TextTableInit(&report);
+  TextTableAdd(&report, NULL, "build + free");
+  TextTableAdd(&report, NULL, "cells/s");
+  TextTableAdd(&report, NULL, "allocs/cell");
+  TextTableAdd(&report, NULL, "allocs");
+  TextTableAdd(&report, NULL, "frees");
+  BenchReport(&report, "heap", BenchBuildFree(0));
+  BenchReport(&report, "arena 4 KiB", BenchBuildFree(4 * 1024));
+  BenchReport(&report, "arena 64 KiB", BenchBuildFree(TEXT_TABLE_ARENA_CHUNK_SIZE));
+  BenchReport(&report, "arena 1 MiB", BenchBuildFree(1024 * 1024));
+  BenchReport(&report, "format short", BenchFormat(false));
+  BenchReport(&report, "format long", BenchFormat(true));
+  BenchReport(&report, "printf int/double/str", BenchTyped(false));
+  BenchReport(&report, "typed int/double/str", BenchTyped(true));
+  BenchReport(&report, "text 92 chars", BenchAddText(
+                "node frankfurt-1, load 0.333, 7 requests, state nominal, uptime 12 days, 3 warnings, 1 error"));
+  BenchReport(&report, "text 89 chars, 4 rows", BenchAddText(
+                "node frankfurt-1, load 0.333\n7 requests, state nominal\nuptime 12 days\n3 warnings, 1 error"));
+  BenchReport(&report, "text UTF-8, 4 rows", BenchAddText(
+                "node m\xC3\xBCnchen-1, load 0.333\n7 requests, latency 12 \xC2\xB5s\n"
+                "\xE7\x8A\xB6\xE6\x85\x8B nominal\n3 warnings, 1 error"));
+  BenchReport(&report, "append, 1 thread", BenchAppend(1));
+  BenchReport(&report, "append, 4 threads", BenchAppend(4));
+  BenchReport(&report, "append, 16 threads", BenchAppend(16));
+  BenchReport(&report, "heap, 100k strings copied", BenchExisting(false));
+  BenchReport(&report, "heap, 100k strings borrowed", BenchExisting(true));
+  printf("\n %d x %d cells, %d loops, %ld CPUs online\n", BENCH_ROWS, BENCH_COLUMNS, BENCH_LOOPS,
+         sysconf(_SC_NPROCESSORS_ONLN));
+  TextTablePrint(&report, PrintLineCallbackFunction, TABSTYLE_REGULAR_HEAD_ON, 1, 5);
+  TextTableFree(&report);
+
+  TextTableInit(&report);
+  TextTableAdd(&report, NULL, "print");
+  TextTableAdd(&report, NULL, "cells/s");
+  TextTableAdd(&report, NULL, "MiB/s");
+  TextTableAdd(&report, NULL, "bytes/cell");
+  TextTableAdd(&report, NULL, "allocs");
+  BenchReportPrint(&report, "regular head on", BenchPrint(TABSTYLE_REGULAR_HEAD_ON, false));
+  BenchReportPrint(&report, "separated head on", BenchPrint(TABSTYLE_SEPARATED_HEAD_ON, false));
+  BenchReportPrint(&report, "compact", BenchPrint(TABSTYLE_COMACT, false));
+  BenchReportPrint(&report, "regular head on, render ctx", BenchPrint(TABSTYLE_REGULAR_HEAD_ON, true));
+  BenchReportPrint(&report, "narrow, 2 columns of 4 chars", BenchPrintShape(2, 4, 1));
+  BenchReportPrint(&report, "wide, 50 columns of 24 chars", BenchPrintShape(50, 24, 1));
+  BenchReportPrint(&report, "multi-line, 10 columns of 3 rows", BenchPrintShape(10, 16, 3));
+  BenchReportPrint(&report, "pages of 50 rows, render ctx", BenchPages());
+  BenchReportPrint(&report, "/dev/null, writev per line", BenchSink(false));
+  BenchReportPrint(&report, "/dev/null, writev per batch", BenchSink(true));
+  BenchReportPrint(&report, "ANSI full", BenchAnsi(TEXT_TABLE_ANSI_FULL, TABSTYLE_REGULAR_HEAD_ON, false));
+  BenchReportPrint(&report, "ANSI minimal", BenchAnsi(TEXT_TABLE_ANSI_MINIMAL, TABSTYLE_REGULAR_HEAD_ON, false));
+  BenchReportPrint(&report, "ANSI strip", BenchAnsi(TEXT_TABLE_ANSI_STRIP, TABSTYLE_REGULAR_HEAD_ON, false));
+  BenchReportPrint(&report, "ANSI full, row colors", BenchAnsi(TEXT_TABLE_ANSI_FULL, TABSTYLE_REGULAR_HEAD_ON, true));
+  BenchReportPrint(&report, "ANSI minimal, row colors",
+                   BenchAnsi(TEXT_TABLE_ANSI_MINIMAL, TABSTYLE_REGULAR_HEAD_ON, true));
+  BenchReportPrint(&report, "ANSI strip, row colors",
+                   BenchAnsi(TEXT_TABLE_ANSI_STRIP, TABSTYLE_REGULAR_HEAD_ON, true));
+  BenchReportPrint(&report, "ANSI full, row colors, compact", BenchAnsi(TEXT_TABLE_ANSI_FULL, TABSTYLE_COMACT, true));
+  BenchReportPrint(&report, "ANSI minimal, row colors, compact",
+                   BenchAnsi(TEXT_TABLE_ANSI_MINIMAL, TABSTYLE_COMACT, true));
+  BenchReportPrint(&report, "colored, 100 columns", BenchWideColored());
+  BenchReportPrint(&report, "parallel, 1 thread", BenchPrintParallel(1));
+  BenchReportPrint(&report, "parallel, 2 threads", BenchPrintParallel(2));
+  BenchReportPrint(&report, "parallel, 4 threads", BenchPrintParallel(4));
+  BenchReportPrint(&report, "parallel, 8 threads", BenchPrintParallel(8));
+  BenchReportPrint(&report, "render regular head on", BenchRender(TABSTYLE_REGULAR_HEAD_ON));
+  BenchReportPrint(&report, "render compact", BenchRender(TABSTYLE_COMACT));
+  BenchReportPrint(&report, "arena build + print", BenchBuildPrint(false));
+  BenchReportPrint(&report, "arena build + print, declared", BenchBuildPrint(true));
+  BenchReportPrint(&report, "stream, heap", BenchStream(0));
+  BenchReportPrint(&report, "stream, arena 4 KiB", BenchStream(4 * 1024));
+  BenchReportPrint(&report, "refresh, build again + print", BenchRefresh(false));
+  BenchReportPrint(&report, "refresh, set 100 cells + print", BenchRefresh(true));
+  BenchReportPrint(&report, "refresh, snapshot + print", BenchSnapshot());
+  printf("\n");
+  TextTablePrint(&report, PrintLineCallbackFunction, TABSTYLE_REGULAR_HEAD_ON, 1, 5);
+  TextTableFree(&report);
+  printf(" row buffer of the colored table with 100 columns: %zu bytes\n", sLineBufSize);
+
+  return 0;
+}
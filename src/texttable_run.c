@@ -8,6 +8,12 @@
 
 #ifdef _WIN32
 #include <windows.h>
+#include <io.h>
+#define isatty _isatty
+#define fileno _fileno
+#else
+#define _POSIX_C_SOURCE 200809L
+#include <unistd.h>
 #endif
 #include <inttypes.h>
 #include <stdio.h>
@@ -39,6 +45,9 @@ int main(int argc, char* argv[])
   }
 #endif
 
+  // no ANSI sequences if the output is redirected to a file or a pipe
+  uint8_t ansiMode = isatty(fileno(stdout)) ? TEXT_TABLE_ANSI_FULL : TEXT_TABLE_ANSI_STRIP;
+
   TextTable_t tTextTable;
   TextTableInit(&tTextTable);
   TextTableAdd(&tTextTable, NULL, "Headline1");
@@ -80,6 +89,7 @@ int main(int argc, char* argv[])
 
   printf("\n TABSTYLE_REGULAR_HEAD_ON - using ANSI sequences\n");
   TextTableInit(&tTextTable);
+  tTextTable.ansiMode = ansiMode;
   TextTableAdd(&tTextTable, "\033[4m", "Head1 underlined");
   TextTableAdd(&tTextTable, "\033[4m", "Head2 underlined");
   TextTableAdd(&tTextTable, "\033[4m", "Head3 underlined");
@@ -98,6 +108,7 @@ int main(int argc, char* argv[])
   printf("\n16 standard and high intensity colors\n");
   TextTableInit(&tTextTable);
   tTextTable.spacesBetweenBorder = 0; // no spaces between borders
+  tTextTable.ansiMode = ansiMode;
   for (size_t i = 0; i < 16; i++)
   {
     snprintf(ansiColor, sizeof(ansiColor), "\x1b[48;5;%zum", i);
@@ -109,6 +120,7 @@ int main(int argc, char* argv[])
   printf("216 colors\n");
   TextTableInit(&tTextTable);
   tTextTable.spacesBetweenBorder = 0; // no spaces between borders
+  tTextTable.ansiMode = ansiMode;
   for (size_t i = 16; i < 232; i++)
   {
     snprintf(ansiColor, sizeof(ansiColor), "\x1b[48;5;%zum", i);
@@ -120,6 +132,7 @@ int main(int argc, char* argv[])
   printf("Grayscale colors\n");
   TextTableInit(&tTextTable);
   tTextTable.spacesBetweenBorder = 0; // no spaces between borders
+  tTextTable.ansiMode = ansiMode;
   for (size_t i = 232; i < 256; i++)
   {
     snprintf(ansiColor, sizeof(ansiColor), "\x1b[48;5;%zum", i);
@@ -7,10 +7,19 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <stdarg.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <limits.h>
+#ifndef __STDC_NO_ATOMICS__
+#include <stdatomic.h>
+#endif
+#ifndef __STDC_NO_THREADS__
+#include <threads.h>
+#endif
 
 //cmocka
 #include <setjmp.h>
@@ -19,7 +28,81 @@
 #include "texttable.h"
 
 
+size_t gTestAllocations = 0;
+#ifndef __STDC_NO_ATOMICS__
+static atomic_flag sAllocLock = ATOMIC_FLAG_INIT;   ///< Guards cmocka's memory check, the workers of TextTablePrintParallel() allocate
+#endif
 static bool sCallbackFunctionCalled = false;
+static char sCaptureBuf[16 * 1024];   ///< Output of @ref PrintLineCapture()
+static size_t sCaptureLen = 0;        ///< Length of the output of @ref PrintLineCapture()
+
+/**
+ * @brief    Lock the heap functions of the implementation, cmocka's memory check is not thread safe
+ */
+static void TestAllocLock(void)
+{
+#ifndef __STDC_NO_ATOMICS__
+  while (atomic_flag_test_and_set_explicit(&sAllocLock, memory_order_acquire))
+  {
+  }
+#endif
+}
+
+/**
+ * @brief    Unlock the heap functions of the implementation
+ */
+static void TestAllocUnlock(void)
+{
+#ifndef __STDC_NO_ATOMICS__
+  atomic_flag_clear_explicit(&sAllocLock, memory_order_release);
+#endif
+}
+
+/**
+ * @brief    Counting `malloc()` of the implementation, see texttable_test.h
+ */
+void* TestMalloc(size_t size, const char* file, int line)
+{
+  TestAllocLock();
+  gTestAllocations++;
+  void* ptr = _test_malloc(size, file, line);
+  TestAllocUnlock();
+  return ptr;
+}
+
+/**
+ * @brief    Counting `calloc()` of the implementation, see texttable_test.h
+ */
+void* TestCalloc(size_t count, size_t size, const char* file, int line)
+{
+  TestAllocLock();
+  gTestAllocations++;
+  void* ptr = _test_calloc(count, size, file, line);
+  TestAllocUnlock();
+  return ptr;
+}
+
+/**
+ * @brief    Counting `realloc()` of the implementation, see texttable_test.h
+ */
+void* TestRealloc(void* ptr, size_t size, const char* file, int line)
+{
+  TestAllocLock();
+  gTestAllocations++;
+  ptr = _test_realloc(ptr, size, file, line);
+  TestAllocUnlock();
+  return ptr;
+}
+
+/**
+ * @brief    `free()` of the implementation, see texttable_test.h
+ */
+void TestFree(void* ptr, const char* file, int line)
+{
+  TestAllocLock();
+  _test_free(ptr, file, line);
+  TestAllocUnlock();
+}
 
 /**
  * @brief    Group setup, called before every test group
@@ -46,6 +129,7 @@ static int TestSetup(void** state)
 {
   (void)state;
   sCallbackFunctionCalled = false;
+  sCaptureLen = 0;
   return 0;
 }
 
@@ -68,6 +152,21 @@ static void PrintLine(const char* line)    ///< [in] the line to be print
   //printf("%s\n", line);
 }
 
+/**
+ * @brief    Callback function for one line output, appends the line and `\n` to @ref sCaptureBuf.
+ */
+static void PrintLineCapture(const char* line)    ///< [in] the line to be print
+{
+  size_t lineLen = strlen(line);
+  if ((sCaptureLen + lineLen + 1) <= sizeof(sCaptureBuf))
+  {
+    memcpy(&sCaptureBuf[sCaptureLen], line, lineLen);
+    sCaptureBuf[sCaptureLen + lineLen] = '\n';
+  }
+  sCaptureLen += lineLen + 1;
+  sCallbackFunctionCalled = true;
+}
+
 /**
  * @brief   Test init with passing a `NULL` pointer.
  */
@@ -88,6 +187,46 @@ void UTest_TextTableInit_Success(void** state)
   TextTableFree(&tTextTable);
 }
 
+/**
+ * @brief   Test arena init with passing a `NULL` pointer.
+ */
+void UTest_TextTableInitArena_Fail(void** state)
+{
+  (void)state;
+  assert_false(TextTableInitArena(NULL, 0));
+}
+
+/**
+ * @brief   Test arena mode with small chunks, so entries are spread over several chunks.
+ */
+void UTest_TextTableInitArena_Chunks(void** state)
+{
+  (void)state;
+  TextTable_t tTextTable;
+  assert_true(TextTableInitArena(&tTextTable, 64));
+  assert_int_equal(tTextTable.chunkSize, 64);
+
+  for (size_t i = 0; i < 32; i++)
+  {
+    assert_true(TextTableAdd(&tTextTable, (i % 2) ? "\033[4m" : NULL, "row%zu column%zu\nsecond line", i / 2, i % 2));
+  }
+  assert_non_null(tTextTable.chunks);
+  assert_non_null(tTextTable.chunks->nextChunk);
+  assert_true(TextTablePrint(&tTextTable, PrintLine, TABSTYLE_SEPARATED_HEAD_ON, 0, 2));
+  assert_true(sCallbackFunctionCalled);
+
+  TextTableFree(&tTextTable);
+  assert_null(tTextTable.chunks);
+  assert_int_equal(tTextTable.entries, 0);
+
+  // the table can be filled again after free
+  assert_true(TextTableInitArena(&tTextTable, 0));
+  assert_int_equal(tTextTable.chunkSize, TEXT_TABLE_ARENA_CHUNK_SIZE);
+  assert_true(TextTableAdd(&tTextTable, NULL, "headline1"));
+  assert_true(TextTablePrint(&tTextTable, PrintLine, TABSTYLE_REGULAR_HEAD_ON, 0, 1));
+  TextTableFree(&tTextTable);
+}
+
 /**
  * @brief   Test free with NULL pointer.
  */
@@ -147,6 +286,650 @@ void UTest_TextTableAdd_formatNULL(void** state)
   TextTableFree(&tTextTable);
 }
 
+/**
+ * @brief   Test that formatted texts longer than @ref TEXT_TABLE_MAX_COLUMN_LEN are truncated.
+ */
+void UTest_TextTableAdd_Truncated(void** state)
+{
+  (void)state;
+  char longText[TEXT_TABLE_MAX_COLUMN_LEN * 2];
+  size_t textLen = 0;
+  for (size_t i = 0; i < sizeof(longText); i++)
+  {
+    longText[i] = (char)('a' + (i % 26));
+  }
+  longText[sizeof(longText) - 1] = 0x00;
+
+  TextTable_t tTextTable;
+  assert_true(TextTableInit(&tTextTable));
+  assert_true(TextTableAdd(&tTextTable, NULL, "%d:%s", 42, longText));
+  const char* text = TextTableGetText(&tTextTable, 1, 0, 0, &textLen);
+  assert_int_equal(textLen, TEXT_TABLE_MAX_COLUMN_LEN);
+  assert_memory_equal(text, "42:", 3);
+  assert_memory_equal(&text[3], longText, TEXT_TABLE_MAX_COLUMN_LEN - 3);
+  TextTableFree(&tTextTable);
+}
+
+/**
+ * @brief   Check that the last added cell has the expected text.
+ */
+static void CheckLastText(const TextTable_t* table, const char* expected)
+{
+  size_t textLen = 0;
+  const char* text = TextTableGetText(table, 1, table->entries - 1, 0, &textLen);
+  assert_int_equal(textLen, strlen(expected));
+  assert_memory_equal(text, expected, textLen);
+}
+
+/**
+ * @brief   Test the integer add functions against `printf()`.
+ */
+void UTest_TextTableAddInt(void** state)
+{
+  (void)state;
+  char expected[32];
+  const int64_t values[] = {0, 1, -1, 9, 10, -10, 99, 100, 101, 12345, -98765, 1000000007, INT64_MAX, INT64_MIN};
+  TextTable_t tTextTable;
+  assert_true(TextTableInit(&tTextTable));
+  assert_false(TextTableAddInt(NULL, NULL, 1));
+  assert_false(TextTableAddUInt(NULL, NULL, 1));
+
+  for (size_t i = 0; i < (sizeof(values) / sizeof(values[0])); i++)
+  {
+    assert_true(TextTableAddInt(&tTextTable, NULL, values[i]));
+    snprintf(expected, sizeof(expected), "%" PRId64, values[i]);
+    CheckLastText(&tTextTable, expected);
+
+    assert_true(TextTableAddUInt(&tTextTable, NULL, (uint64_t)values[i]));
+    snprintf(expected, sizeof(expected), "%" PRIu64, (uint64_t)values[i]);
+    CheckLastText(&tTextTable, expected);
+  }
+  TextTableFree(&tTextTable);
+}
+
+/**
+ * @brief   Test the double add function against `printf()` and the shortest round-trip representation.
+ */
+void UTest_TextTableAddDouble(void** state)
+{
+  (void)state;
+  char expected[TEXT_TABLE_MAX_COLUMN_LEN + 1];
+  const double values[] = {0.0, -0.0, 0.5, 1.5, 2.5, 0.125, 2.675, 0.1, -0.001, 3.14159265358979, 1e-7, 123456.789,
+                           9.995, 1e15, 1.7976931348623157e308, 5e-324, -2.0 / 3.0, 1e300 * 1e300, -(1e300 * 1e300)};
+  TextTable_t tTextTable;
+  assert_true(TextTableInit(&tTextTable));
+  assert_false(TextTableAddDouble(NULL, NULL, 1.0, 2));
+
+  for (size_t i = 0; i < (sizeof(values) / sizeof(values[0])); i++)
+  {
+    for (int precision = 0; precision <= 12; precision++)
+    {
+      assert_true(TextTableAddDouble(&tTextTable, NULL, values[i], precision));
+      snprintf(expected, sizeof(expected), "%.*f", precision, values[i]);
+      CheckLastText(&tTextTable, expected);
+    }
+    // shortest round-trip
+    assert_true(TextTableAddDouble(&tTextTable, NULL, values[i], -1));
+    size_t textLen = 0;
+    const char* text = TextTableGetText(&tTextTable, 1, tTextTable.entries - 1, 0, &textLen);
+    memcpy(expected, text, textLen);
+    expected[textLen] = 0x00;
+    assert_true((strtod(expected, NULL) == values[i]) || (values[i] != values[i]));
+  }
+
+  const struct
+  {
+    double value;
+    const char* text;
+  }shortest[] = {{0.1, "0.1"}, {-2.5, "-2.5"}, {100.0, "100"}, {3.14, "3.14"}, {1e300, "1e+300"}, {1.0 / 3.0, "0.3333333333333333"}};
+  for (size_t i = 0; i < (sizeof(shortest) / sizeof(shortest[0])); i++)
+  {
+    assert_true(TextTableAddDouble(&tTextTable, NULL, shortest[i].value, -1));
+    CheckLastText(&tTextTable, shortest[i].text);
+  }
+  TextTableFree(&tTextTable);
+}
+
+/**
+ * @brief   Test the string add function, newlines split the entry like with @ref TextTableAdd().
+ */
+void UTest_TextTableAddStr(void** state)
+{
+  (void)state;
+  TextTable_t tTextTable;
+  assert_true(TextTableInit(&tTextTable));
+  assert_false(TextTableAddStr(NULL, NULL, "test", 4));
+
+  assert_true(TextTableAddStr(&tTextTable, "\033[4m", "line1\nlonger line2 not copied", 18));
+  CheckLastText(&tTextTable, "line1\nlonger line2");
+  assert_int_equal(tTextTable.cells.rowMaxTextLen[0], 12);
+  assert_int_not_equal(tTextTable.cells.styleId[0], 0);
+
+  assert_true(TextTableAddStr(&tTextTable, "\033[4m", NULL, 5));
+  assert_null(TextTableGetText(&tTextTable, 1, 1, 0, NULL));
+  assert_int_equal(tTextTable.cells.styleId[1], 0);
+  assert_int_equal(tTextTable.cells.rowMaxTextLen[1], 0);
+
+  assert_true(TextTablePrint(&tTextTable, PrintLine, TABSTYLE_REGULAR_HEAD_ON, 0, 1));
+  TextTableFree(&tTextTable);
+}
+
+/**
+ * @brief   Test the style table: each ANSI sequence is stored once, cells refer to it by id.
+ */
+void UTest_TextTableStyles(void** state)
+{
+  (void)state;
+  static const char* const sColors[] = {"\033[0;31m", "\033[0;32m", "\033[0;33m"};
+  TextTable_t tTextTable;
+  TextTable_t tRows;
+  assert_true(TextTableInit(&tTextTable));
+  assert_true(TextTableInitColumns(&tTextTable, 2));
+  assert_true(TextTableInit(&tRows));
+
+  // no allocation for the sequences of the cells
+  size_t allocations = gTestAllocations;
+  for (size_t cell = 0; cell < 100; cell++)
+  {
+    assert_true(TextTableAddStr(&tTextTable, sColors[cell % 3], "x", 1));
+  }
+  assert_int_equal(tTextTable.styles.count, 3);
+  assert_true(gTestAllocations < (allocations + 100 + 20));
+  assert_int_equal(tTextTable.cells.styleId[0], 1);
+  assert_int_equal(tTextTable.cells.styleId[4], 2);
+  assert_int_equal(tTextTable.cells.ansiSeqLen[5], strlen(sColors[2]));
+
+  // appended rows bring their own style ids
+  assert_true(TextTableAddStr(&tRows, sColors[2], "red", 3));
+  assert_true(TextTableAddStr(&tRows, "\033[1m", "bold", 4));
+  assert_true(TextTableAppend(&tTextTable, &tRows));
+  assert_int_equal(tTextTable.styles.count, 4);
+  assert_int_equal(tTextTable.cells.styleId[100], 3);
+  assert_int_equal(tTextTable.cells.styleId[101], 4);
+  assert_true(TextTableSet(&tTextTable, 50, 1, sColors[0], "set"));
+  assert_int_equal(tTextTable.cells.styleId[101], 1);
+  assert_true(TextTableSet(&tTextTable, 50, 1, NULL, "set"));
+  assert_int_equal(tTextTable.cells.styleId[101], 0);
+  assert_int_equal(tTextTable.styles.count, 4);
+  TextTableFree(&tRows);
+  TextTableFree(&tTextTable);
+
+  // one more different sequence than styles: the cell is not added, known and no sequences still work
+  assert_true(TextTableInit(&tTextTable));
+  for (size_t cell = 0; cell <= TEXT_TABLE_MAX_STYLES; cell++)
+  {
+    char ansiSeq[16];
+    snprintf(ansiSeq, sizeof(ansiSeq), "\033[38;5;%zum", cell);
+    if (cell < TEXT_TABLE_MAX_STYLES)
+    {
+      assert_true(TextTableAdd(&tTextTable, ansiSeq, "c"));
+    }
+    else
+    {
+      assert_false(TextTableAdd(&tTextTable, ansiSeq, "c"));
+    }
+  }
+  assert_int_equal(tTextTable.entries, TEXT_TABLE_MAX_STYLES);
+  assert_int_equal(tTextTable.styles.count, TEXT_TABLE_MAX_STYLES);
+  assert_int_equal(tTextTable.cells.styleId[TEXT_TABLE_MAX_STYLES - 1], TEXT_TABLE_MAX_STYLES);
+  assert_true(TextTableAdd(&tTextTable, "\033[38;5;0m", "known"));
+  assert_int_equal(tTextTable.cells.styleId[TEXT_TABLE_MAX_STYLES], 1);
+  assert_true(TextTableAdd(&tTextTable, NULL, "plain"));
+  assert_int_equal(tTextTable.cells.styleId[TEXT_TABLE_MAX_STYLES + 1], 0);
+  assert_true(TextTableAdd(&tTextTable, "\033[4m", "%s", ""));
+  assert_int_equal(tTextTable.entries, TEXT_TABLE_MAX_STYLES + 3);
+  TextTableFree(&tTextTable);
+
+  // the same with declared columns: a new style for a cell fails, the cell is unchanged
+  assert_true(TextTableInit(&tTextTable));
+  assert_true(TextTableInitColumns(&tTextTable, 5));
+  for (size_t cell = 0; cell < TEXT_TABLE_MAX_STYLES; cell++)
+  {
+    assert_true(TextTableAdd(&tTextTable, (0 == (cell % 2)) ? "\033[1m" : NULL, "c"));
+  }
+  for (size_t style = 1; style < TEXT_TABLE_MAX_STYLES; style++)
+  {
+    char ansiSeq[16];
+    snprintf(ansiSeq, sizeof(ansiSeq), "\033[38;5;%zum", style);
+    assert_true(TextTableSet(&tTextTable, 0, 0, ansiSeq, "s"));
+  }
+  assert_false(TextTableSet(&tTextTable, 1, 1, "\033[4m", "new"));
+  assert_string_equal(TextTableGetText(&tTextTable, 5, 1, 1, NULL), "c");
+  assert_int_equal(tTextTable.cells.styleId[6], 1);
+  TextTableFree(&tTextTable);
+}
+
+/**
+ * @brief   Look of each character of rendered lines, interprets the SGR sequences like a terminal.
+ *          Spaces only show the background, underline, inverse and strike-through.
+ * @return  Number of characters
+ */
+static size_t AnsiLooks(
+  const char* out,      ///< [in] Rendered lines
+  size_t len,           ///< [in] Length of the lines
+  char* chars,          ///< [out] The characters without sequences
+  uint64_t* looks,      ///< [out] The look of each character
+  size_t cap)           ///< [in] Size of `chars` and `looks`
+{
+  uint64_t fg = 0;
+  uint64_t bg = 0;
+  uint64_t attr = 0;
+  size_t count = 0;
+  for (size_t i = 0; i < len; i++)
+  {
+    if (0x1B == out[i])
+    {
+      assert_true((i + 1) < len);
+      assert_int_equal(out[i + 1], '[');
+      unsigned params[16] = {0};
+      size_t n = 0;
+      for (i += 2; 'm' != out[i]; i++)
+      {
+        if (';' == out[i])
+        {
+          n++;
+        }
+        else
+        {
+          params[n] = (params[n] * 10) + (unsigned)(out[i] - '0');
+        }
+      }
+      for (size_t p = 0; p <= n; p++)
+      {
+        unsigned v = params[p];
+        if (0 == v)
+        {
+          fg = bg = attr = 0;
+        }
+        else if (38 == v)
+        {
+          fg = 1000 + params[p + 2];
+          p += 2;
+        }
+        else if (v < 10)
+        {
+          attr |= (uint64_t)1 << v;
+        }
+        else if ((v >= 22) && (v < 30))
+        {
+          attr &= ~((uint64_t)1 << (v - 20));
+        }
+        else if (((v >= 30) && (v <= 37)) || ((v >= 90) && (v <= 97)))
+        {
+          fg = v;
+        }
+        else if (((v >= 40) && (v <= 47)) || ((v >= 100) && (v <= 107)))
+        {
+          bg = v;
+        }
+      }
+      continue;
+    }
+    assert_true(count < cap);
+    chars[count] = out[i];
+    if ((' ' == out[i]) || ('\n' == out[i]))
+    {
+      looks[count] = (bg << 16) | (attr & (((uint64_t)1 << 4) | ((uint64_t)1 << 7) | ((uint64_t)1 << 9)));
+    }
+    else
+    {
+      looks[count] = (fg << 32) | (bg << 16) | attr;
+    }
+    count++;
+  }
+  return count;
+}
+
+/**
+ * @brief   Test the minimal ANSI output: fewer bytes, but every character looks like with the full output.
+ */
+void UTest_TextTableAnsiMinimal(void** state)
+{
+  (void)state;
+  static const TabStyle_e sStyles[] = {TABSTYLE_COMACT, TABSTYLE_REGULAR_HEAD_ON, TABSTYLE_REGULAR_HEAD_OFF,
+                                       TABSTYLE_SEPARATED_HEAD_ON, TABSTYLE_SEPARATED_HEAD_OFF};
+  static const char* const sAnsiSeqs[] = {"\033[31m", "\033[31m", "\033[0;32m", NULL, "\033[41m", "\033[1;31m",
+                                          "\033[38;5;208m", "\033[4m", "\033[0;32m", "\033[7;33m", NULL, "\033[31m"};
+  static const char* const sTexts[] = {"red", "red too", "green\nline2\nline3", "plain", "background", "bold",
+                                       "orange", "underline", "", "inverse", "", "x\ny"};
+  static char sFull[4096];
+  static char sMinimal[4096];
+  static char sFullChars[4096];
+  static char sMinimalChars[4096];
+  static uint64_t sFullLooks[4096];
+  static uint64_t sMinimalLooks[4096];
+  TextTable_t tTextTable;
+  assert_true(TextTableInit(&tTextTable));
+  assert_int_equal(tTextTable.ansiMode, TEXT_TABLE_ANSI_FULL);
+  for (size_t cell = 0; cell < (sizeof(sTexts) / sizeof(sTexts[0])); cell++)
+  {
+    assert_true(TextTableAdd(&tTextTable, sAnsiSeqs[cell], "%s", sTexts[cell]));
+  }
+
+  for (size_t i = 0; i < (sizeof(sStyles) / sizeof(sStyles[0])); i++)
+  {
+    size_t needed = 0;
+    tTextTable.ansiMode = TEXT_TABLE_ANSI_FULL;
+    size_t fullLen = TextTableRender(&tTextTable, sStyles[i], 2, 3, sFull, sizeof(sFull), &needed);
+    assert_int_equal(fullLen, needed);
+    tTextTable.ansiMode = TEXT_TABLE_ANSI_MINIMAL;
+    size_t minimalLen = TextTableRender(&tTextTable, sStyles[i], 2, 3, sMinimal, sizeof(sMinimal), &needed);
+    assert_int_not_equal(minimalLen, 0);
+    assert_true(minimalLen < fullLen);
+    assert_true(minimalLen <= needed);
+
+    size_t fullCount = AnsiLooks(sFull, fullLen, sFullChars, sFullLooks, sizeof(sFullChars));
+    size_t minimalCount = AnsiLooks(sMinimal, minimalLen, sMinimalChars, sMinimalLooks, sizeof(sMinimalChars));
+    assert_int_equal(fullCount, minimalCount);
+    assert_memory_equal(sFullChars, sMinimalChars, fullCount);
+    assert_memory_equal(sFullLooks, sMinimalLooks, fullCount * sizeof(sFullLooks[0]));
+
+    // each line ends with the default style
+    for (size_t j = 0; j < minimalCount; j++)
+    {
+      if ('\n' == sMinimalChars[j])
+      {
+        assert_int_equal(sMinimalLooks[j], 0);
+      }
+    }
+  }
+
+  // compact style: a row of one color needs a single sequence and a single short reset
+  TextTableFree(&tTextTable);
+  assert_true(TextTableInit(&tTextTable));
+  assert_true(TextTableInitColumns(&tTextTable, 3));
+  tTextTable.ansiMode = TEXT_TABLE_ANSI_MINIMAL;
+  assert_true(TextTableAdd(&tTextTable, "\033[32m", "a"));
+  assert_true(TextTableAdd(&tTextTable, "\033[32m", "bb"));
+  assert_true(TextTableAdd(&tTextTable, "\033[32m", "ccc"));
+  size_t len = TextTableRender(&tTextTable, TABSTYLE_COMACT, 0, 3, sMinimal, sizeof(sMinimal), NULL);
+  const char expected[] = "\033[32ma  bb  ccc \033[m\n";
+  assert_int_equal(len, sizeof(expected) - 1);
+  assert_memory_equal(sMinimal, expected, len);
+
+  // other sequences than SGR are kept around their text
+  assert_true(TextTableSet(&tTextTable, 0, 1, "\033]8;;x\033\\", "bb"));
+  len = TextTableRender(&tTextTable, TABSTYLE_COMACT, 0, 3, sMinimal, sizeof(sMinimal), NULL);
+  const char expectedOsc[] = "\033[32ma  \033[m\033]8;;x\033\\bb\033[m  \033[32mccc \033[m\n";
+  assert_int_equal(len, sizeof(expectedOsc) - 1);
+  assert_memory_equal(sMinimal, expectedOsc, len);
+  TextTableFree(&tTextTable);
+}
+
+/**
+ * @brief   Test the row buffer: display width plus the ANSI bytes of the row with the most ANSI bytes,
+ *          not the longest sequence of every column.
+ */
+void UTest_TextTableRowBuffer(void** state)
+{
+  (void)state;
+  static const char sLong[] = "\033[38;2;255;128;0m";
+  static char sOut[4096];
+  const size_t ansiLen = (sizeof(sLong) - 1) + 4; // sequence and closing tag
+  for (size_t declared = 0; declared < 2; declared++)
+  {
+    TextTable_t tTextTable;
+    TextTableRenderCtx_t ctx;
+    assert_true(TextTableInit(&tTextTable));
+    assert_true(TextTableRenderCtxInit(&ctx));
+    if (0 != declared)
+    {
+      assert_true(TextTableInitColumns(&tTextTable, 4));
+    }
+
+    // one highlighted cell per row, in a different column each row
+    for (size_t cell = 0; cell < 16; cell++)
+    {
+      assert_true(TextTableAdd(&tTextTable, ((cell % 4) == (cell / 4)) ? sLong : NULL, "c%zu", cell % 10));
+    }
+    size_t needed = 0;
+    size_t len = TextTableRenderCtx(&tTextTable, &ctx, TABSTYLE_REGULAR_HEAD_ON, 0, 4, sOut, sizeof(sOut), &needed);
+    assert_int_not_equal(len, 0);
+    assert_int_equal(len, needed);
+    // "| c0 | c1 | c2 | c3 |" and '\0'
+    assert_int_equal(ctx.layout.rowLen, 21 + 1 + ansiLen);
+    for (size_t i = 0, start = 0; i < len; i++)
+    {
+      if ('\n' == sOut[i])
+      {
+        size_t lineLen = i - start;
+        assert_true((21 == lineLen) || ((21 + ansiLen) == lineLen));
+        start = i + 1;
+      }
+    }
+
+    // a row with two highlighted cells, in the middle or at the end of the table
+    if (0 != declared)
+    {
+      assert_true(TextTableSet(&tTextTable, 2, 0, sLong, "c8"));
+    }
+    else
+    {
+      assert_true(TextTableAdd(&tTextTable, sLong, "c6"));
+      assert_true(TextTableAdd(&tTextTable, sLong, "c7"));
+      assert_true(TextTableAdd(&tTextTable, NULL, "c8"));
+      assert_true(TextTableAdd(&tTextTable, NULL, "c9"));
+    }
+    len = TextTableRenderCtx(&tTextTable, &ctx, TABSTYLE_REGULAR_HEAD_ON, 0, 4, sOut, sizeof(sOut), &needed);
+    assert_int_not_equal(len, 0);
+    assert_int_equal(len, needed);
+    assert_int_equal(ctx.layout.rowLen, 21 + 1 + (2 * ansiLen));
+
+    TextTableRenderCtxFree(&ctx);
+    TextTableFree(&tTextTable);
+  }
+}
+
+/**
+ * @brief   Test the output without ANSI sequences: the same as a table built without sequences.
+ */
+void UTest_TextTableAnsiStrip(void** state)
+{
+  (void)state;
+  static const char* const sAnsiSeqs[] = {"\033[4m", "\033[38;2;255;128;0m", NULL, "\033[0;34m", "\033[46;37m", NULL};
+  static const char* const sTexts[] = {"head1", "head2", "head3", "blue", "cyan\nline2", "plain"};
+  static char sStyled[2048];
+  static char sPlain[2048];
+  TextTable_t tTextTable;
+  TextTable_t tPlain;
+  TextTableRenderCtx_t ctx;
+  TextTableRenderCtx_t ctxPlain;
+  assert_true(TextTableInit(&tTextTable));
+  assert_true(TextTableInit(&tPlain));
+  assert_true(TextTableRenderCtxInit(&ctx));
+  assert_true(TextTableRenderCtxInit(&ctxPlain));
+  for (size_t cell = 0; cell < (sizeof(sTexts) / sizeof(sTexts[0])); cell++)
+  {
+    assert_true(TextTableAdd(&tTextTable, sAnsiSeqs[cell], "%s", sTexts[cell]));
+    assert_true(TextTableAdd(&tPlain, NULL, "%s", sTexts[cell]));
+  }
+
+  for (TabStyle_e tabStyle = TABSTYLE_REGULAR_HEAD_ON; tabStyle <= TABSTYLE_COMACT; tabStyle++)
+  {
+    size_t needed = 0;
+    tTextTable.ansiMode = TEXT_TABLE_ANSI_FULL;
+    size_t fullLen = TextTableRenderCtx(&tTextTable, &ctx, tabStyle, 1, 3, sStyled, sizeof(sStyled), NULL);
+    assert_int_not_equal(fullLen, 0);
+    size_t fullRowLen = ctx.layout.rowLen;
+
+    tTextTable.ansiMode = TEXT_TABLE_ANSI_STRIP;
+    size_t len = TextTableRenderCtx(&tTextTable, &ctx, tabStyle, 1, 3, sStyled, sizeof(sStyled), &needed);
+    size_t plainLen = TextTableRenderCtx(&tPlain, &ctxPlain, tabStyle, 1, 3, sPlain, sizeof(sPlain), NULL);
+    assert_int_not_equal(len, 0);
+    assert_int_equal(len, needed);
+    assert_int_equal(len, plainLen);
+    assert_memory_equal(sStyled, sPlain, len);
+    assert_null(memchr(sStyled, 0x1B, len));
+    assert_true(len < fullLen);
+
+    // the row buffer is sized for the plain output
+    assert_int_equal(ctx.layout.rowLen, ctxPlain.layout.rowLen);
+    assert_true(ctx.layout.rowLen < fullRowLen);
+  }
+
+  // the same table prints the sequences again
+  tTextTable.ansiMode = TEXT_TABLE_ANSI_FULL;
+  assert_true(TextTablePrintCtx(&tTextTable, &ctx, PrintLineCapture, TABSTYLE_COMACT, 0, 3));
+  assert_non_null(memchr(sCaptureBuf, 0x1B, sCaptureLen));
+
+  TextTableRenderCtxFree(&ctxPlain);
+  TextTableRenderCtxFree(&ctx);
+  TextTableFree(&tPlain);
+  TextTableFree(&tTextTable);
+}
+
+/**
+ * @brief   Test the display width of UTF-8 texts: wide and combining characters, truncation of long texts
+ *          and of fixed column widths at whole characters.
+ */
+void UTest_TextTableUtf8(void** state)
+{
+  (void)state;
+  static const size_t sNarrowWidths[] = {3, 2};
+  static char sOut[1024];
+  static const struct
+  {
+    const char* text;
+    size_t width;
+  }widths[] =
+  {
+    {"ascii", 5}, {"12 \xC2\xB5s", 5}, {"\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E", 6}, {"e\xCC\x81t\xC3\xA9", 3},
+    {"\xF0\x9F\x98\x80!", 3}, {"bad \xFF\xC3", 6}, {"\xEF\xBC\xA1\n\xC3\xA4\xC3\xB6\xC3\xBC\xC3\x9F", 4},
+    {"\xC0\x80", 2}, {"\xE0\x80\xBF", 3}, {"\xF0\x80\x80\x80", 4}, {"\xED\xA0\x80", 3}, {"\xED\xBF\xBF", 3},
+    {"\xF4\x90\x80\x80", 4}, {"\xED\x9F\xBF", 1}, {"\xF4\x8F\xBF\xBF", 1}, {"\xE3\x80\x80", 2}
+  };
+  TextTable_t tTextTable;
+  assert_true(TextTableInit(&tTextTable));
+  for (size_t i = 0; i < (sizeof(widths) / sizeof(widths[0])); i++)
+  {
+    assert_true(TextTableAdd(&tTextTable, NULL, "%s", widths[i].text));
+    assert_int_equal(tTextTable.cells.rowMaxTextLen[i], widths[i].width);
+    assert_int_equal((tTextTable.cells.flags[i] & TEXT_TABLE_CELL_UTF8) != 0, i != 0);
+  }
+  TextTableFree(&tTextTable);
+
+  // the grid is aligned by display width, the output size is exact
+  assert_true(TextTableInit(&tTextTable));
+  assert_true(TextTableAdd(&tTextTable, NULL, "host"));
+  assert_true(TextTableAdd(&tTextTable, NULL, "\xC2\xB5s"));
+  assert_true(TextTableAdd(&tTextTable, "\033[1m", "\xE6\x97\xA5\xE6\x9C\xAC"));
+  assert_true(TextTableAdd(&tTextTable, NULL, "a\xCC\x81" "b\nc"));
+  const char expected[] =
+    "+======+====+\n"
+    "| host | \xC2\xB5s |\n"
+    "+======+====+\n"
+    "| \033[1m\xE6\x97\xA5\xE6\x9C\xAC\033[0m | a\xCC\x81" "b |\n"
+    "| \033[1m    \033[0m | c  |\n"
+    "+------+----+\n";
+  size_t needed = 0;
+  size_t len = TextTableRender(&tTextTable, TABSTYLE_REGULAR_HEAD_ON, 0, 2, sOut, sizeof(sOut), &needed);
+  assert_int_equal(len, sizeof(expected) - 1);
+  assert_int_equal(len, needed);
+  assert_memory_equal(sOut, expected, len);
+  TextTableFree(&tTextTable);
+
+  // long texts are cut in front of a multibyte character, not in it
+  char text[TEXT_TABLE_MAX_COLUMN_LEN + 8];
+  memset(text, 'a', sizeof(text));
+  memcpy(&text[TEXT_TABLE_MAX_COLUMN_LEN - 2], "\xE6\x97\xA5", 3);
+  size_t textLen = 0;
+  assert_true(TextTableInit(&tTextTable));
+  assert_true(TextTableInitColumns(&tTextTable, 2));
+  assert_true(TextTableAddStr(&tTextTable, NULL, text, sizeof(text)));
+  assert_non_null(TextTableGetText(&tTextTable, 2, 0, 0, &textLen));
+  assert_int_equal(textLen, TEXT_TABLE_MAX_COLUMN_LEN - 2);
+  assert_true(TextTableAddStr(&tTextTable, NULL, text, TEXT_TABLE_MAX_COLUMN_LEN + 1));
+  assert_true(TextTableSet(&tTextTable, 0, 0, NULL, "%.*s", (int)sizeof(text), text));
+  assert_non_null(TextTableGetText(&tTextTable, 2, 0, 0, &textLen));
+  assert_int_equal(textLen, TEXT_TABLE_MAX_COLUMN_LEN - 2);
+  assert_true(TextTableSet(&tTextTable, 0, 1, NULL, "\xC3\xA4%.*s", TEXT_TABLE_MAX_COLUMN_LEN - 2, text));
+  assert_non_null(TextTableGetText(&tTextTable, 2, 0, 1, &textLen));
+  assert_int_equal(textLen, TEXT_TABLE_MAX_COLUMN_LEN);
+  assert_int_equal(tTextTable.cells.rowMaxTextLen[1], TEXT_TABLE_MAX_COLUMN_LEN - 1);
+  assert_true(TextTablePrint(&tTextTable, PrintLine, TABSTYLE_COMACT, 0, 2));
+  TextTableFree(&tTextTable);
+
+  // an embedded `\0` ends the output: ASCII and multibyte texts are measured up to it,
+  // short texts by the byte scan, long texts by the block scan
+  static const char sNulAscii[] = "ab\ncd\0efghijklmnopqrstuvwxyz0123456789\nlonger row";
+  static const char sNulUtf8[] = "\xC3\xA4" "b\ncd\0efghijklmnopqrstuvwxyz\xC3\xA4\xC3\xB6\xC3\xBC\nlonger row";
+  static char sExpectedOut[sizeof(sOut)];
+  TextTable_t tVisibleTable;
+  assert_true(TextTableInit(&tTextTable));
+  assert_true(TextTableAddStr(&tTextTable, NULL, sNulAscii, sizeof(sNulAscii) - 1));
+  assert_true(TextTableAddRef(&tTextTable, "\033[1m", sNulUtf8, sizeof(sNulUtf8) - 1));
+  assert_true(TextTableAddRef(&tTextTable, NULL, "ab\0cdefg", 8));
+  assert_true(TextTableAddStr(&tTextTable, "\033[1m", "\xC3\xA4" "b\0cdefg", 9));
+  for (size_t cell = 0; cell < 4; cell++)
+  {
+    assert_int_equal(tTextTable.cells.rowMaxTextLen[cell], 2);
+    assert_int_equal(tTextTable.cells.textRows[cell], (cell < 2) ? 2 : 1);
+  }
+  assert_int_equal(tTextTable.cells.flags[0] & TEXT_TABLE_CELL_UTF8, 0);
+  assert_int_not_equal(tTextTable.cells.flags[1] & TEXT_TABLE_CELL_UTF8, 0);
+  assert_true(TextTableInit(&tVisibleTable));
+  assert_true(TextTableAdd(&tVisibleTable, NULL, "ab\ncd"));
+  assert_true(TextTableAdd(&tVisibleTable, "\033[1m", "\xC3\xA4" "b\ncd"));
+  assert_true(TextTableAdd(&tVisibleTable, NULL, "ab"));
+  assert_true(TextTableAdd(&tVisibleTable, "\033[1m", "\xC3\xA4" "b"));
+  for (size_t style = TABSTYLE_REGULAR_HEAD_ON; style <= TABSTYLE_COMACT; style++)
+  {
+    size_t expectedLen = TextTableRender(&tVisibleTable, (TabStyle_e)style, 1, 2, sExpectedOut,
+                                         sizeof(sExpectedOut), NULL);
+    assert_int_not_equal(expectedLen, 0);
+    len = TextTableRender(&tTextTable, (TabStyle_e)style, 1, 2, sOut, sizeof(sOut), &needed);
+    assert_int_equal(len, expectedLen);
+    assert_int_equal(needed, expectedLen);
+    assert_memory_equal(sOut, sExpectedOut, len);
+  }
+  TextTableFree(&tVisibleTable);
+  TextTableFree(&tTextTable);
+
+  // fixed column widths cut at whole characters, the padding fills the display width
+  TextTableStream_t stream;
+  assert_true(TextTableInit(&tTextTable));
+  sCaptureLen = 0;
+  assert_true(TextTableStreamBegin(&tTextTable, &stream, PrintLineCapture, TABSTYLE_COMACT, 0, 2, sNarrowWidths, 0));
+  assert_true(TextTableAdd(&tTextTable, NULL, "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E"));
+  assert_true(TextTableAdd(&tTextTable, NULL, "a\xCC\x81" "bc"));
+  assert_true(TextTableStreamEnd(&tTextTable));
+  const char expectedFixed[] = "\xE6\x97\xA5   a\xCC\x81" "b \n";
+  assert_int_equal(sCaptureLen, sizeof(expectedFixed) - 1);
+  assert_memory_equal(sCaptureBuf, expectedFixed, sCaptureLen);
+  TextTableFree(&tTextTable);
+}
+
+/**
+ * @brief   Test the zero-copy add function, only the pointer of the text is stored.
+ */
+void UTest_TextTableAddRef(void** state)
+{
+  (void)state;
+  static const char sNames[] = "host-a\nrack-1host-b";
+  size_t textLen = 0;
+  TextTable_t tTextTable;
+  assert_true(TextTableInit(&tTextTable));
+  assert_false(TextTableAddRef(NULL, NULL, sNames, 6));
+
+  assert_true(TextTableAddRef(&tTextTable, NULL, sNames, 13));
+  assert_true(TextTableAddRef(&tTextTable, "\033[4m", &sNames[13], 6));
+  assert_true(TextTableAddRef(&tTextTable, NULL, NULL, 6));
+  assert_true(TextTableAdd(&tTextTable, NULL, "copied"));
+
+  assert_true(TextTableGetText(&tTextTable, 2, 0, 0, &textLen) == sNames);
+  assert_int_equal(textLen, 13);
+  assert_int_equal(tTextTable.cells.rowMaxTextLen[0], 6);
+  assert_int_equal(tTextTable.cells.flags[0], TEXT_TABLE_CELL_BORROWED);
+  assert_true(TextTableGetText(&tTextTable, 2, 0, 1, &textLen) == &sNames[13]);
+  assert_int_equal(textLen, 6);
+  assert_null(TextTableGetText(&tTextTable, 2, 1, 0, NULL));
+  assert_int_equal(tTextTable.cells.flags[3], 0);
+
+  assert_true(TextTablePrint(&tTextTable, PrintLine, TABSTYLE_SEPARATED_HEAD_ON, 0, 2));
+  assert_true(sCallbackFunctionCalled);
+  TextTableFree(&tTextTable);
+}
+
 /**
  * @brief   Test function @ref TextTablePrint() called with wrong column count.
  *          Table has 3 entries but @ref TextTablePrint() is called with 2 columns.
@@ -271,6 +1054,1530 @@ void UTest_TextTablePrint_SequenceOK(void** state)
   TextTableFree(&tTextTable);
 }
 
+/**
+ * @brief   Test the output of all table styles, right shifts and border settings with multi-line and colored cells,
+ *          byte for byte. The expected lines are the output of the per-character rendering before the line templates.
+ */
+void UTest_TextTablePrint_Styles(void** state)
+{
+  (void)state;
+  static const struct
+  {
+    size_t posX;
+    size_t spaces;
+    bool customChars;
+    const char* expected[TABSTYLE_COMACT + 1];
+  }sCases[] =
+  {
+    {0, 1, false,
+     {
+      "+=====+=======+=======+\n"
+      "| id  | name  | note  |\n"
+      "+=====+=======+=======+\n"
+      "| 1   | \033[1malpha\033[0m | x     |\n"
+      "| 22  | b     | \033[31mmulti\033[0m |\n"
+      "|     |       | \033[31mline \033[0m |\n"
+      "|     |       | \033[31mtext \033[0m |\n"
+      "| 333 | c     | y     |\n"
+      "| 4   |       |       |\n"
+      "+-----+-------+-------+\n",
+      "+-----+-------+-------+\n"
+      "| id  | name  | note  |\n"
+      "| 1   | \033[1malpha\033[0m | x     |\n"
+      "| 22  | b     | \033[31mmulti\033[0m |\n"
+      "|     |       | \033[31mline \033[0m |\n"
+      "|     |       | \033[31mtext \033[0m |\n"
+      "| 333 | c     | y     |\n"
+      "| 4   |       |       |\n"
+      "+-----+-------+-------+\n",
+      "+=====+=======+=======+\n"
+      "| id  | name  | note  |\n"
+      "+=====+=======+=======+\n"
+      "| 1   | \033[1malpha\033[0m | x     |\n"
+      "+-----+-------+-------+\n"
+      "| 22  | b     | \033[31mmulti\033[0m |\n"
+      "|     |       | \033[31mline \033[0m |\n"
+      "|     |       | \033[31mtext \033[0m |\n"
+      "+-----+-------+-------+\n"
+      "| 333 | c     | y     |\n"
+      "| 4   |       |       |\n"
+      "+-----+-------+-------+\n",
+      "+-----+-------+-------+\n"
+      "| id  | name  | note  |\n"
+      "+-----+-------+-------+\n"
+      "| 1   | \033[1malpha\033[0m | x     |\n"
+      "+-----+-------+-------+\n"
+      "| 22  | b     | \033[31mmulti\033[0m |\n"
+      "|     |       | \033[31mline \033[0m |\n"
+      "|     |       | \033[31mtext \033[0m |\n"
+      "+-----+-------+-------+\n"
+      "| 333 | c     | y     |\n"
+      "| 4   |       |       |\n"
+      "+-----+-------+-------+\n",
+      "id   name   note  \n"
+      "1    \033[1malpha\033[0m  x     \n"
+      "22   b      \033[31mmulti\033[0m \n"
+      "            \033[31mline \033[0m \n"
+      "            \033[31mtext \033[0m \n"
+      "333  c      y     \n"
+      "4                 \n"
+     }
+    },
+    {2, 1, false,
+     {
+      "  +=====+=======+=======+\n"
+      "  | id  | name  | note  |\n"
+      "  +=====+=======+=======+\n"
+      "  | 1   | \033[1malpha\033[0m | x     |\n"
+      "  | 22  | b     | \033[31mmulti\033[0m |\n"
+      "  |     |       | \033[31mline \033[0m |\n"
+      "  |     |       | \033[31mtext \033[0m |\n"
+      "  | 333 | c     | y     |\n"
+      "  | 4   |       |       |\n"
+      "  +-----+-------+-------+\n",
+      "  +-----+-------+-------+\n"
+      "  | id  | name  | note  |\n"
+      "  | 1   | \033[1malpha\033[0m | x     |\n"
+      "  | 22  | b     | \033[31mmulti\033[0m |\n"
+      "  |     |       | \033[31mline \033[0m |\n"
+      "  |     |       | \033[31mtext \033[0m |\n"
+      "  | 333 | c     | y     |\n"
+      "  | 4   |       |       |\n"
+      "  +-----+-------+-------+\n",
+      "  +=====+=======+=======+\n"
+      "  | id  | name  | note  |\n"
+      "  +=====+=======+=======+\n"
+      "  | 1   | \033[1malpha\033[0m | x     |\n"
+      "  +-----+-------+-------+\n"
+      "  | 22  | b     | \033[31mmulti\033[0m |\n"
+      "  |     |       | \033[31mline \033[0m |\n"
+      "  |     |       | \033[31mtext \033[0m |\n"
+      "  +-----+-------+-------+\n"
+      "  | 333 | c     | y     |\n"
+      "  | 4   |       |       |\n"
+      "  +-----+-------+-------+\n",
+      "  +-----+-------+-------+\n"
+      "  | id  | name  | note  |\n"
+      "  +-----+-------+-------+\n"
+      "  | 1   | \033[1malpha\033[0m | x     |\n"
+      "  +-----+-------+-------+\n"
+      "  | 22  | b     | \033[31mmulti\033[0m |\n"
+      "  |     |       | \033[31mline \033[0m |\n"
+      "  |     |       | \033[31mtext \033[0m |\n"
+      "  +-----+-------+-------+\n"
+      "  | 333 | c     | y     |\n"
+      "  | 4   |       |       |\n"
+      "  +-----+-------+-------+\n",
+      "  id   name   note  \n"
+      "  1    \033[1malpha\033[0m  x     \n"
+      "  22   b      \033[31mmulti\033[0m \n"
+      "              \033[31mline \033[0m \n"
+      "              \033[31mtext \033[0m \n"
+      "  333  c      y     \n"
+      "  4                 \n"
+     }
+    },
+    {1, 2, true,
+     {
+      " *#######*#########*#########*\n"
+      " [  id   :  name   :  note   [\n"
+      " *#######*#########*#########*\n"
+      " !  1    :  \033[1malpha\033[0m  :  x      !\n"
+      " !  22   :  b      :  \033[31mmulti\033[0m  !\n"
+      " !       :         :  \033[31mline \033[0m  !\n"
+      " !       :         :  \033[31mtext \033[0m  !\n"
+      " !  333  :  c      :  y      !\n"
+      " !  4    :         :         !\n"
+      " *~~~~~~~*~~~~~~~~~*~~~~~~~~~*\n",
+      " *~~~~~~~*~~~~~~~~~*~~~~~~~~~*\n"
+      " !  id   :  name   :  note   !\n"
+      " !  1    :  \033[1malpha\033[0m  :  x      !\n"
+      " !  22   :  b      :  \033[31mmulti\033[0m  !\n"
+      " !       :         :  \033[31mline \033[0m  !\n"
+      " !       :         :  \033[31mtext \033[0m  !\n"
+      " !  333  :  c      :  y      !\n"
+      " !  4    :         :         !\n"
+      " *~~~~~~~*~~~~~~~~~*~~~~~~~~~*\n",
+      " *#######*#########*#########*\n"
+      " [  id   :  name   :  note   [\n"
+      " *#######*#########*#########*\n"
+      " !  1    :  \033[1malpha\033[0m  :  x      !\n"
+      " *~~~~~~~*~~~~~~~~~*~~~~~~~~~*\n"
+      " !  22   :  b      :  \033[31mmulti\033[0m  !\n"
+      " !       :         :  \033[31mline \033[0m  !\n"
+      " !       :         :  \033[31mtext \033[0m  !\n"
+      " *~~~~~~~*~~~~~~~~~*~~~~~~~~~*\n"
+      " !  333  :  c      :  y      !\n"
+      " !  4    :         :         !\n"
+      " *~~~~~~~*~~~~~~~~~*~~~~~~~~~*\n",
+      " *~~~~~~~*~~~~~~~~~*~~~~~~~~~*\n"
+      " !  id   :  name   :  note   !\n"
+      " *~~~~~~~*~~~~~~~~~*~~~~~~~~~*\n"
+      " !  1    :  \033[1malpha\033[0m  :  x      !\n"
+      " *~~~~~~~*~~~~~~~~~*~~~~~~~~~*\n"
+      " !  22   :  b      :  \033[31mmulti\033[0m  !\n"
+      " !       :         :  \033[31mline \033[0m  !\n"
+      " !       :         :  \033[31mtext \033[0m  !\n"
+      " *~~~~~~~*~~~~~~~~~*~~~~~~~~~*\n"
+      " !  333  :  c      :  y      !\n"
+      " !  4    :         :         !\n"
+      " *~~~~~~~*~~~~~~~~~*~~~~~~~~~*\n",
+      " id     name     note   \n"
+      " 1      \033[1malpha\033[0m    x      \n"
+      " 22     b        \033[31mmulti\033[0m  \n"
+      "                 \033[31mline \033[0m  \n"
+      "                 \033[31mtext \033[0m  \n"
+      " 333    c        y      \n"
+      " 4                      \n"
+     }
+    }
+  };
+  for (size_t i = 0; i < (sizeof(sCases) / sizeof(sCases[0])); i++)
+  {
+    TextTable_t tTextTable;
+    assert_true(TextTableInit(&tTextTable));
+    assert_true(TextTableAdd(&tTextTable, NULL, "id"));
+    assert_true(TextTableAdd(&tTextTable, NULL, "name"));
+    assert_true(TextTableAdd(&tTextTable, NULL, "note"));
+    assert_true(TextTableAdd(&tTextTable, NULL, "1"));
+    assert_true(TextTableAdd(&tTextTable, "\033[1m", "alpha"));
+    assert_true(TextTableAdd(&tTextTable, NULL, "x"));
+    assert_true(TextTableAdd(&tTextTable, NULL, "22"));
+    assert_true(TextTableAdd(&tTextTable, NULL, "b"));
+    assert_true(TextTableAdd(&tTextTable, "\033[31m", "multi\nline\ntext"));
+    assert_true(TextTableAdd(&tTextTable, NULL, "333\n4"));
+    assert_true(TextTableAdd(&tTextTable, NULL, "c"));
+    assert_true(TextTableAdd(&tTextTable, NULL, "y"));
+    tTextTable.spacesBetweenBorder = sCases[i].spaces;
+    if (sCases[i].customChars)
+    {
+      tTextTable.charGridX = '~';
+      tTextTable.charGridBoundary = '!';
+      tTextTable.charGridSeparator = ':';
+      tTextTable.charHeadX = '#';
+      tTextTable.charHeadBoundary = '[';
+      tTextTable.charHeadSeparator = ']';
+      tTextTable.charConnectorXY = '*';
+    }
+    for (size_t style = TABSTYLE_REGULAR_HEAD_ON; style <= TABSTYLE_COMACT; style++)
+    {
+      sCaptureLen = 0;
+      assert_true(TextTablePrint(&tTextTable, PrintLineCapture, (TabStyle_e)style, sCases[i].posX, 3));
+      assert_int_equal(sCaptureLen, strlen(sCases[i].expected[style]));
+      assert_memory_equal(sCaptureBuf, sCases[i].expected[style], sCaptureLen);
+    }
+    TextTableFree(&tTextTable);
+  }
+}
+
+/**
+ * @brief   Test direct access to the table cells.
+ */
+void UTest_TextTableGetText(void** state)
+{
+  (void)state;
+  size_t textLen = 0;
+  TextTable_t tTextTable;
+  assert_true(TextTableInit(&tTextTable));
+  assert_null(TextTableGetText(&tTextTable, 2, 0, 0, &textLen));
+
+  assert_true(TextTableAdd(&tTextTable, NULL, "headline1"));
+  assert_true(TextTableAdd(&tTextTable, NULL, "headline2"));
+  assert_true(TextTableAdd(&tTextTable, NULL, "row%d column%d", 1, 1));
+  assert_true(TextTableAdd(&tTextTable, NULL, NULL));
+
+  assert_memory_equal(TextTableGetText(&tTextTable, 2, 0, 1, &textLen), "headline2", 9);
+  assert_int_equal(textLen, 9);
+  assert_memory_equal(TextTableGetText(&tTextTable, 2, 1, 0, &textLen), "row1 column1", 12);
+  assert_int_equal(textLen, 12);
+  assert_memory_equal(TextTableGetText(&tTextTable, 1, 2, 0, NULL), "row1 column1", 12);
+  assert_null(TextTableGetText(&tTextTable, 2, 1, 1, &textLen));
+  assert_int_equal(textLen, 0);
+  assert_null(TextTableGetText(&tTextTable, 2, 2, 0, NULL));
+  assert_null(TextTableGetText(&tTextTable, 2, 0, 2, NULL));
+  assert_null(TextTableGetText(&tTextTable, 0, 0, 0, NULL));
+  assert_null(TextTableGetText(NULL, 2, 0, 0, NULL));
+
+  TextTableFree(&tTextTable);
+}
+
+/**
+ * @brief   Fill the table with entries of different length, multiple rows and ANSI sequences.
+ */
+static void FillTable(TextTable_t* table)
+{
+  assert_true(TextTableAdd(table, "\033[43;34;64m", "headline1 color changed"));
+  assert_true(TextTableAdd(table, NULL, "headline2"));
+  assert_true(TextTableAdd(table, "\033[4m", "headline3 underlined"));
+  assert_true(TextTableAdd(table, "\033[0;34m", "row1 column1_row1"));
+  assert_true(TextTableAdd(table, "\033[0;33m", "row1 column2_row1\nrow1 clmn2_r2\nrow1 column2_row3"));
+  assert_true(TextTableAdd(table, NULL, "row1 column3_row1\n"));
+  assert_true(TextTableAdd(table, NULL, NULL));
+  assert_true(TextTableAdd(table, NULL, "row2 column2_row1"));
+  assert_true(TextTableAdd(table, NULL, "row2 clmn3_row1\n\nrow2 column3_row3"));
+  assert_true(TextTableAdd(table, NULL, "%d", 3));
+  assert_true(TextTableAdd(table, "\033[1m", "%d", 3));
+  assert_true(TextTableAdd(table, NULL, "%d", 3));
+}
+
+/**
+ * @brief   Test that @ref TextTableRender() gives exactly the lines of @ref TextTablePrint() for all styles.
+ */
+void UTest_TextTableRender_SameAsPrint(void** state)
+{
+  (void)state;
+  static char sRenderBuf[sizeof(sCaptureBuf)];
+  size_t needed = 0;
+  TextTable_t tTextTable;
+  assert_true(TextTableInit(&tTextTable));
+  FillTable(&tTextTable);
+
+  for (size_t style = TABSTYLE_REGULAR_HEAD_ON; style <= TABSTYLE_COMACT; style++)
+  {
+    for (size_t spaces = 0; spaces < 3; spaces++)
+    {
+      tTextTable.spacesBetweenBorder = spaces;
+      sCaptureLen = 0;
+      assert_true(TextTablePrint(&tTextTable, PrintLineCapture, (TabStyle_e)style, spaces, 3));
+      assert_int_equal(TextTableRender(&tTextTable, (TabStyle_e)style, spaces, 3, NULL, 0, &needed), 0);
+      assert_int_equal(needed, sCaptureLen);
+      assert_int_equal(TextTableRender(&tTextTable, (TabStyle_e)style, spaces, 3, sRenderBuf, needed - 1, NULL), 0);
+      assert_int_equal(TextTableRender(&tTextTable, (TabStyle_e)style, spaces, 3, sRenderBuf, sizeof(sRenderBuf), &needed), sCaptureLen);
+      assert_memory_equal(sRenderBuf, sCaptureBuf, sCaptureLen);
+    }
+  }
+  TextTableFree(&tTextTable);
+}
+
+/**
+ * @brief   Test @ref TextTableRender() with invalid arguments.
+ */
+void UTest_TextTableRender_Fail(void** state)
+{
+  (void)state;
+  char buf[64];
+  size_t needed = 1;
+  TextTable_t tTextTable;
+  assert_true(TextTableInit(&tTextTable));
+  assert_int_equal(TextTableRender(NULL, TABSTYLE_REGULAR_HEAD_ON, 0, 1, buf, sizeof(buf), &needed), 0);
+  assert_int_equal(needed, 0);
+  assert_int_equal(TextTableRender(&tTextTable, TABSTYLE_REGULAR_HEAD_ON, 0, 1, buf, sizeof(buf), NULL), 0);
+
+  assert_true(TextTableAdd(&tTextTable, NULL, "headline1"));
+  assert_true(TextTableAdd(&tTextTable, NULL, "headline2"));
+  assert_true(TextTableAdd(&tTextTable, NULL, "headline3"));
+  assert_int_equal(TextTableRender(&tTextTable, TABSTYLE_REGULAR_HEAD_ON, 0, 2, buf, sizeof(buf), &needed), 0);
+  assert_int_equal(needed, 0);
+  assert_int_equal(TextTableRender(&tTextTable, TABSTYLE_REGULAR_HEAD_ON, TEXT_TABLE_MAX_X_POS + 1, 3, buf, sizeof(buf), &needed), 0);
+  assert_int_equal(TextTableRender(&tTextTable, TABSTYLE_REGULAR_HEAD_ON, 0, 0, buf, sizeof(buf), &needed), 0);
+  TextTableFree(&tTextTable);
+}
+
+/**
+ * @brief   Test the column widths maintained by @ref TextTableAdd() with declared columns.
+ */
+void UTest_TextTableInitColumns(void** state)
+{
+  (void)state;
+  static char sExpectedBuf[sizeof(sCaptureBuf)];
+  size_t expectedLen = 0;
+  TextTable_t tTextTable;
+  TextTable_t tDeclaredTable;
+  assert_false(TextTableInitColumns(NULL, 3));
+  assert_true(TextTableInit(&tTextTable));
+  assert_true(TextTableInitArena(&tDeclaredTable, 0));
+  assert_false(TextTableInitColumns(&tDeclaredTable, 0));
+  assert_true(TextTableInitColumns(&tDeclaredTable, 3));
+  FillTable(&tTextTable);
+  FillTable(&tDeclaredTable);
+  assert_false(TextTableInitColumns(&tDeclaredTable, 3));
+
+  // the widths are up to date before the first print
+  assert_int_equal(tDeclaredTable.layout->entries, tDeclaredTable.entries);
+  assert_false(TextTablePrint(&tTextTable, PrintLine, TABSTYLE_SEPARATED_HEAD_ON, 1, 0));
+  for (size_t style = TABSTYLE_REGULAR_HEAD_ON; style <= TABSTYLE_COMACT; style++)
+  {
+    sCaptureLen = 0;
+    assert_true(TextTablePrint(&tTextTable, PrintLineCapture, (TabStyle_e)style, 1, 3));
+    memcpy(sExpectedBuf, sCaptureBuf, sCaptureLen);
+    expectedLen = sCaptureLen;
+    sCaptureLen = 0;
+    assert_true(TextTablePrint(&tDeclaredTable, PrintLineCapture, (TabStyle_e)style, 1, 0));
+    assert_int_equal(sCaptureLen, expectedLen);
+    assert_memory_equal(sCaptureBuf, sExpectedBuf, expectedLen);
+  }
+
+  // wider entry after the print
+  assert_true(TextTableAdd(&tTextTable, NULL, "%s", "a much wider entry"));
+  assert_true(TextTableAdd(&tDeclaredTable, NULL, "%s", "a much wider entry"));
+  assert_false(TextTablePrint(&tDeclaredTable, PrintLine, TABSTYLE_SEPARATED_HEAD_ON, 1, 0));
+  assert_true(TextTableAdd(&tTextTable, NULL, NULL));
+  assert_true(TextTableAdd(&tDeclaredTable, NULL, NULL));
+  assert_true(TextTableAdd(&tTextTable, NULL, "x"));
+  assert_true(TextTableAdd(&tDeclaredTable, NULL, "x"));
+  assert_int_equal(tDeclaredTable.layout->entries, tDeclaredTable.entries);
+  sCaptureLen = 0;
+  assert_true(TextTablePrint(&tTextTable, PrintLineCapture, TABSTYLE_REGULAR_HEAD_ON, 0, 3));
+  memcpy(sExpectedBuf, sCaptureBuf, sCaptureLen);
+  expectedLen = sCaptureLen;
+  sCaptureLen = 0;
+  assert_true(TextTablePrint(&tDeclaredTable, PrintLineCapture, TABSTYLE_REGULAR_HEAD_ON, 0, 3));
+  assert_int_equal(sCaptureLen, expectedLen);
+  assert_memory_equal(sCaptureBuf, sExpectedBuf, expectedLen);
+
+  TextTableFree(&tTextTable);
+  TextTableFree(&tDeclaredTable);
+}
+
+/**
+ * @brief   Check that the table prints exactly like a new table built from `texts` and `ansiSeqs` (3 x 3 cells).
+ */
+static void CheckSameAsNewTable(TextTable_t* table, const char* const* texts, const char* const* ansiSeqs)
+{
+  static char sExpectedBuf[sizeof(sCaptureBuf)];
+  TextTable_t tNewTable;
+  assert_true(TextTableInit(&tNewTable));
+  for (size_t idx = 0; idx < 9; idx++)
+  {
+    assert_true(TextTableAddStr(&tNewTable, ansiSeqs[idx], texts[idx], (NULL == texts[idx]) ? 0 : strlen(texts[idx])));
+  }
+  for (size_t style = TABSTYLE_REGULAR_HEAD_ON; style <= TABSTYLE_COMACT; style++)
+  {
+    sCaptureLen = 0;
+    assert_true(TextTablePrint(&tNewTable, PrintLineCapture, (TabStyle_e)style, 1, 3));
+    size_t expectedLen = sCaptureLen;
+    memcpy(sExpectedBuf, sCaptureBuf, sCaptureLen);
+    sCaptureLen = 0;
+    assert_true(TextTablePrint(table, PrintLineCapture, (TabStyle_e)style, 1, 0));
+    assert_int_equal(sCaptureLen, expectedLen);
+    assert_memory_equal(sCaptureBuf, sExpectedBuf, expectedLen);
+  }
+  TextTableFree(&tNewTable);
+}
+
+/**
+ * @brief   Test @ref TextTableSet() with growing and shrinking columns.
+ */
+void UTest_TextTableSet(void** state)
+{
+  (void)state;
+  static const char sBorrowed[] = "borrowed";
+  const char* texts[9] = {"head1", "head2", "head3", "a", "bb", "ccc", "dddd", "e\ne", NULL};
+  const char* ansiSeqs[9] = {NULL, "\033[1m", NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+  TextTable_t tTextTable;
+  assert_false(TextTableSet(NULL, 0, 0, NULL, "x"));
+  assert_true(TextTableInit(&tTextTable));
+  assert_true(TextTableAdd(&tTextTable, NULL, "x"));
+  assert_false(TextTableSet(&tTextTable, 0, 0, NULL, "y"));   // no declared columns
+  TextTableFree(&tTextTable);
+
+  for (size_t chunkSize = 0; chunkSize <= 256; chunkSize += 256)
+  {
+    if (0 == chunkSize)
+    {
+      assert_true(TextTableInit(&tTextTable));
+    }
+    else
+    {
+      assert_true(TextTableInitArena(&tTextTable, chunkSize));
+    }
+    assert_true(TextTableInitColumns(&tTextTable, 3));
+    for (size_t idx = 0; idx < 8; idx++)
+    {
+      assert_true(TextTableAdd(&tTextTable, ansiSeqs[idx], "%s", texts[idx]));
+    }
+    assert_true(TextTableAddRef(&tTextTable, NULL, sBorrowed, sizeof(sBorrowed) - 1));
+    texts[8] = sBorrowed;
+    CheckSameAsNewTable(&tTextTable, texts, ansiSeqs);
+    assert_false(TextTableSet(&tTextTable, 3, 0, NULL, "x"));
+    assert_false(TextTableSet(&tTextTable, 0, 3, NULL, "x"));
+
+    // grow
+    assert_true(TextTableSet(&tTextTable, 1, 1, "\033[0;31m", "a much longer text %d", 42));
+    texts[4] = "a much longer text 42";
+    ansiSeqs[4] = "\033[0;31m";
+    CheckSameAsNewTable(&tTextTable, texts, ansiSeqs);
+
+    // shrink, the storage is reused
+    size_t textLen = 0;
+    const char* pText = TextTableGetText(&tTextTable, 3, 1, 1, &textLen);
+    size_t allocations = gTestAllocations;
+    assert_true(TextTableSet(&tTextTable, 1, 1, "\033[1m", "b"));
+    assert_int_equal(gTestAllocations, allocations);
+    assert_ptr_equal(TextTableGetText(&tTextTable, 3, 1, 1, &textLen), pText);
+    assert_int_equal(textLen, 1);
+    texts[4] = "b";
+    ansiSeqs[4] = "\033[1m";
+    CheckSameAsNewTable(&tTextTable, texts, ansiSeqs);
+
+    // remove the widest entry and the only ANSI sequence of a column, replace a borrowed entry
+    assert_true(TextTableSet(&tTextTable, 0, 1, NULL, "h2"));
+    assert_true(TextTableSet(&tTextTable, 2, 0, NULL, NULL));
+    assert_true(TextTableSet(&tTextTable, 2, 2, NULL, "copy"));
+    assert_null(TextTableGetText(&tTextTable, 3, 2, 0, NULL));
+    texts[1] = "h2";
+    ansiSeqs[1] = NULL;
+    texts[6] = NULL;
+    texts[8] = "copy";
+    CheckSameAsNewTable(&tTextTable, texts, ansiSeqs);
+    assert_true(TextTableSet(&tTextTable, 2, 0, NULL, "dddd"));
+    texts[6] = "dddd";
+    CheckSameAsNewTable(&tTextTable, texts, ansiSeqs);
+
+    TextTableFree(&tTextTable);
+    texts[1] = "head2";
+    ansiSeqs[1] = "\033[1m";
+    texts[4] = "bb";
+    ansiSeqs[4] = NULL;
+  }
+}
+
+/**
+ * @brief   Fill the table with the header and the rows `[firstRow, lastRow)` of a table where all rows have the same width.
+ */
+static void FillPage(TextTable_t* table, size_t firstRow, size_t lastRow)
+{
+  assert_true(TextTableAdd(table, "\033[1m", "name"));
+  assert_true(TextTableAdd(table, NULL, "value"));
+  for (size_t row = firstRow; row < lastRow; row++)
+  {
+    assert_true(TextTableAdd(table, NULL, "row%02zu", row));
+    assert_true(TextTableAdd(table, NULL, (0 == (row % 3)) ? "%zu\n%zu" : "%zu", row * 1000, row));
+  }
+}
+
+/**
+ * @brief   State of @ref PrintLinesCapture()
+ */
+typedef struct
+{
+  size_t calls;       ///< Number of calls
+  size_t lines;       ///< Number of lines of all calls
+  size_t errors;      ///< Number of batches that are not contiguous or too large
+}T_LinesCapture;
+
+/**
+ * @brief   Batch callback function, appends the lines to @ref sCaptureBuf and checks the batch.
+ */
+static void PrintLinesCapture(void* context, const char* const* lines, const size_t* lens, size_t count)
+{
+  T_LinesCapture* pCapture = (T_LinesCapture*)context;
+  pCapture->calls++;
+  pCapture->lines += count;
+  if ((0 == count) || (count > TEXT_TABLE_BATCH_LINES))
+  {
+    pCapture->errors++;
+  }
+  for (size_t i = 0; i < count; i++)
+  {
+    if (((0 != i) && (lines[i] != (lines[i - 1] + lens[i - 1]))) || ('\n' != lines[i][lens[i] - 1]))
+    {
+      pCapture->errors++;
+    }
+    if ((sCaptureLen + lens[i]) <= sizeof(sCaptureBuf))
+    {
+      memcpy(&sCaptureBuf[sCaptureLen], lines[i], lens[i]);
+    }
+    sCaptureLen += lens[i];
+  }
+}
+
+/**
+ * @brief   Test @ref TextTablePrintBatch() against @ref TextTablePrint().
+ */
+void UTest_TextTablePrintBatch(void** state)
+{
+  (void)state;
+  static char sExpectedBuf[sizeof(sCaptureBuf)];
+  T_LinesCapture capture;
+  TextTableRenderCtx_t ctx;
+  TextTable_t tTextTable;
+  assert_true(TextTableRenderCtxInit(&ctx));
+  assert_true(TextTableInit(&tTextTable));
+  FillPage(&tTextTable, 1, 40);
+  assert_false(TextTablePrintBatch(NULL, &ctx, PrintLinesCapture, &capture, TABSTYLE_REGULAR_HEAD_ON, 0, 2));
+  assert_false(TextTablePrintBatch(&tTextTable, &ctx, NULL, &capture, TABSTYLE_REGULAR_HEAD_ON, 0, 2));
+  assert_false(TextTablePrintBatch(&tTextTable, NULL, NULL, &capture, TABSTYLE_REGULAR_HEAD_ON, 0, 2));
+  assert_false(TextTablePrintBatch(&tTextTable, &ctx, PrintLinesCapture, &capture, TABSTYLE_REGULAR_HEAD_ON, 0, 3));
+
+  for (size_t style = TABSTYLE_REGULAR_HEAD_ON; style <= TABSTYLE_COMACT; style++)
+  {
+    sCaptureLen = 0;
+    assert_true(TextTablePrint(&tTextTable, PrintLineCapture, (TabStyle_e)style, 1, 2));
+    size_t expectedLen = sCaptureLen;
+    memcpy(sExpectedBuf, sCaptureBuf, sCaptureLen);
+    size_t expectedLines = 0;
+    for (size_t i = 0; i < expectedLen; i++)
+    {
+      expectedLines += ('\n' == sExpectedBuf[i]) ? 1 : 0;
+    }
+
+    for (size_t withCtx = 0; withCtx < 2; withCtx++)
+    {
+      memset(&capture, 0, sizeof(capture));
+      sCaptureLen = 0;
+      assert_true(TextTablePrintBatch(&tTextTable, (0 != withCtx) ? &ctx : NULL, PrintLinesCapture, &capture,
+                                      (TabStyle_e)style, 1, 2));
+      assert_int_equal(capture.errors, 0);
+      assert_int_equal(capture.lines, expectedLines);
+      assert_int_equal(capture.calls, (expectedLines + TEXT_TABLE_BATCH_LINES - 1) / TEXT_TABLE_BATCH_LINES);
+      assert_int_equal(sCaptureLen, expectedLen);
+      assert_memory_equal(sCaptureBuf, sExpectedBuf, expectedLen);
+    }
+  }
+
+  // steady state
+  size_t allocations = gTestAllocations;
+  assert_true(TextTablePrintBatch(&tTextTable, &ctx, PrintLinesCapture, &capture, TABSTYLE_REGULAR_HEAD_ON, 0, 2));
+  assert_int_equal(gTestAllocations, allocations);
+
+  // long lines: the batch is passed on before the buffer is full, only the lengths are compared
+  TextTable_t tWideTable;
+  assert_true(TextTableInit(&tWideTable));
+  for (size_t cell = 0; cell < (8 * 40); cell++)
+  {
+    assert_true(TextTableAdd(&tWideTable, NULL, "%090zu", cell));
+  }
+  sCaptureLen = 0;
+  assert_true(TextTablePrint(&tWideTable, PrintLineCapture, TABSTYLE_REGULAR_HEAD_ON, 0, 8));
+  size_t expectedLen = sCaptureLen;
+  memset(&capture, 0, sizeof(capture));
+  sCaptureLen = 0;
+  assert_true(TextTablePrintBatch(&tWideTable, &ctx, PrintLinesCapture, &capture, TABSTYLE_REGULAR_HEAD_ON, 0, 8));
+  assert_int_equal(capture.errors, 0);
+  assert_int_equal(capture.lines, 43);
+  size_t batchLines = TEXT_TABLE_BATCH_SIZE / (expectedLen / 43); // all lines have the same length
+  assert_int_equal(capture.calls, (43 + batchLines - 1) / batchLines);
+  assert_int_equal(sCaptureLen, expectedLen);
+  TextTableFree(&tWideTable);
+  TextTableRenderCtxFree(&ctx);
+  TextTableFree(&tTextTable);
+}
+
+/**
+ * @brief   Test @ref TextTablePrintRange() against complete tables with the same rows.
+ */
+void UTest_TextTablePrintRange(void** state)
+{
+  (void)state;
+  static char sExpectedBuf[sizeof(sCaptureBuf)];
+  TextTableRenderCtx_t ctx;
+  TextTable_t tTextTable;
+  assert_true(TextTableRenderCtxInit(&ctx));
+  assert_true(TextTableInit(&tTextTable));
+  FillPage(&tTextTable, 1, 40);
+  assert_false(TextTablePrintRange(&tTextTable, NULL, PrintLine, TABSTYLE_REGULAR_HEAD_ON, 0, 2, 0, 1, false));
+  assert_false(TextTablePrintRange(&tTextTable, &ctx, NULL, TABSTYLE_REGULAR_HEAD_ON, 0, 2, 0, 1, false));
+  assert_false(TextTablePrintRange(&tTextTable, &ctx, PrintLine, TABSTYLE_REGULAR_HEAD_ON, 0, 2, 5, 5, false));
+  assert_false(TextTablePrintRange(&tTextTable, &ctx, PrintLine, TABSTYLE_REGULAR_HEAD_ON, 0, 2, 5, 41, false));
+  assert_false(TextTablePrintRange(&tTextTable, &ctx, PrintLine, TABSTYLE_REGULAR_HEAD_ON, 0, 3, 0, 1, false));
+
+  for (size_t style = TABSTYLE_REGULAR_HEAD_ON; style <= TABSTYLE_COMACT; style++)
+  {
+    // whole table
+    sCaptureLen = 0;
+    assert_true(TextTablePrint(&tTextTable, PrintLineCapture, (TabStyle_e)style, 1, 2));
+    size_t expectedLen = sCaptureLen;
+    memcpy(sExpectedBuf, sCaptureBuf, sCaptureLen);
+    sCaptureLen = 0;
+    assert_true(TextTablePrintRange(&tTextTable, &ctx, PrintLineCapture, (TabStyle_e)style, 1, 2, 0, 40, true));
+    assert_int_equal(sCaptureLen, expectedLen);
+    assert_memory_equal(sCaptureBuf, sExpectedBuf, expectedLen);
+
+    // pages with header
+    for (size_t firstRow = 1; firstRow < 40; firstRow += 12)
+    {
+      size_t lastRow = (firstRow + 12 < 40) ? (firstRow + 12) : 40;
+      TextTable_t tPageTable;
+      assert_true(TextTableInit(&tPageTable));
+      FillPage(&tPageTable, firstRow, lastRow);
+      sCaptureLen = 0;
+      assert_true(TextTablePrint(&tPageTable, PrintLineCapture, (TabStyle_e)style, 1, 2));
+      expectedLen = sCaptureLen;
+      memcpy(sExpectedBuf, sCaptureBuf, sCaptureLen);
+      sCaptureLen = 0;
+      assert_true(TextTablePrintRange(&tTextTable, &ctx, PrintLineCapture, (TabStyle_e)style, 1, 2, firstRow, lastRow, true));
+      assert_int_equal(sCaptureLen, expectedLen);
+      assert_memory_equal(sCaptureBuf, sExpectedBuf, expectedLen);
+      TextTableFree(&tPageTable);
+    }
+  }
+
+  // page without header, the first row is framed like all other rows
+  sCaptureLen = 0;
+  assert_true(TextTablePrintRange(&tTextTable, &ctx, PrintLineCapture, TABSTYLE_SEPARATED_HEAD_ON, 0, 2, 2, 4, false));
+  sCaptureBuf[sCaptureLen] = 0x00;
+  assert_string_equal(sCaptureBuf,
+    "+-------+-------+\n"
+    "| row02 | 2000  |\n"
+    "+-------+-------+\n"
+    "| row03 | 3000  |\n"
+    "|       | 3     |\n"
+    "+-------+-------+\n");
+
+  TextTableRenderCtxFree(&ctx);
+  TextTableFree(&tTextTable);
+}
+
+/**
+ * @brief   Test streamed tables against the complete table with the same rows.
+ */
+void UTest_TextTableStream(void** state)
+{
+  (void)state;
+  static char sExpectedBuf[sizeof(sCaptureBuf)];
+  static const size_t sWidths[] = {5, 5};
+  static const size_t sNarrowWidths[] = {3, 2};
+  TextTableStream_t stream;
+  TextTable_t tTextTable;
+  TextTable_t tStreamTable;
+  assert_true(TextTableInit(&tTextTable));
+  FillPage(&tTextTable, 1, 40);
+  assert_false(TextTableStreamBegin(NULL, &stream, PrintLine, TABSTYLE_REGULAR_HEAD_ON, 0, 2, NULL, 0));
+  assert_false(TextTableStreamBegin(&tTextTable, &stream, PrintLine, TABSTYLE_REGULAR_HEAD_ON, 0, 2, NULL, 0)); // not empty
+  assert_false(TextTableStreamEnd(&tTextTable));
+
+  for (size_t style = TABSTYLE_REGULAR_HEAD_ON; style <= TABSTYLE_COMACT; style++)
+  {
+    sCaptureLen = 0;
+    assert_true(TextTablePrint(&tTextTable, PrintLineCapture, (TabStyle_e)style, 1, 2));
+    size_t expectedLen = sCaptureLen;
+    memcpy(sExpectedBuf, sCaptureBuf, sCaptureLen);
+
+    // sampled widths (all rows, first 3 rows) and fixed widths, heap and arena
+    for (size_t mode = 0; mode < 6; mode++)
+    {
+      if (mode & 1)
+      {
+        assert_true(TextTableInitArena(&tStreamTable, 128));
+      }
+      else
+      {
+        assert_true(TextTableInit(&tStreamTable));
+      }
+      const size_t* widths = (mode >= 4) ? sWidths : NULL;
+      size_t sampleRows = (mode < 2) ? 100 : 3;
+      sCaptureLen = 0;
+      assert_true(TextTableStreamBegin(&tStreamTable, &stream, PrintLineCapture, (TabStyle_e)style, 1, 2, widths, sampleRows));
+      assert_false(TextTableStreamBegin(&tStreamTable, &stream, PrintLineCapture, (TabStyle_e)style, 1, 2, widths, sampleRows));
+      FillPage(&tStreamTable, 1, 40);
+      assert_true(TextTableStreamEnd(&tStreamTable));
+      assert_int_equal(sCaptureLen, expectedLen);
+      assert_memory_equal(sCaptureBuf, sExpectedBuf, expectedLen);
+      if (mode >= 2)
+      {
+        // only the header is kept
+        assert_int_equal(tStreamTable.entries, 2);
+        assert_true((NULL == tStreamTable.chunks) || (NULL == tStreamTable.chunks->nextChunk));
+      }
+      TextTableFree(&tStreamTable);
+    }
+  }
+
+  // fixed widths truncate longer texts, an incomplete row is not printed
+  assert_true(TextTableInit(&tStreamTable));
+  sCaptureLen = 0;
+  assert_true(TextTableStreamBegin(&tStreamTable, &stream, PrintLineCapture, TABSTYLE_SEPARATED_HEAD_OFF, 0, 2, sNarrowWidths, 0));
+  assert_true(TextTableAdd(&tStreamTable, NULL, "abcdef"));
+  assert_true(TextTableAdd(&tStreamTable, "\033[1m", "xyz\nq"));
+  assert_true(TextTableAdd(&tStreamTable, NULL, "1"));
+  assert_true(TextTableAdd(&tStreamTable, NULL, "2"));
+  assert_true(TextTableAdd(&tStreamTable, NULL, "3"));
+  assert_true(TextTableAdd(&tStreamTable, NULL, "4"));
+  assert_true(TextTableAdd(&tStreamTable, NULL, "incomplete"));
+  assert_false(TextTableStreamEnd(&tStreamTable));
+  sCaptureBuf[sCaptureLen] = 0x00;
+  assert_string_equal(sCaptureBuf,
+    "+-----+----+\n"
+    "| abc | \033[1mxy\033[0m |\n"
+    "|     | \033[1mq \033[0m |\n"
+    "+-----+----+\n"
+    "| 1   | 2  |\n"
+    "+-----+----+\n"
+    "| 3   | 4  |\n"
+    "+-----+----+\n");
+  TextTableFree(&tStreamTable);
+
+  // after the end the stream widths are dropped, later rows are measured, printed and changed as usual
+  for (size_t mode = 0; mode < 2; mode++)
+  {
+    TextTable_t tExpected;
+    assert_true(TextTableInit(&tStreamTable));
+    assert_true(TextTableInit(&tExpected));
+    assert_true(TextTableInitColumns(&tExpected, 2));
+    assert_true(TextTableStreamBegin(&tStreamTable, &stream, PrintLine, TABSTYLE_REGULAR_HEAD_ON, 0, 2,
+                                     (0 == mode) ? sNarrowWidths : NULL, 1));
+    assert_true(TextTableAdd(&tStreamTable, NULL, "name"));
+    assert_true(TextTableAdd(&tStreamTable, NULL, "value"));
+    assert_true(TextTableAdd(&tStreamTable, NULL, "a"));
+    assert_true(TextTableAdd(&tStreamTable, NULL, "1"));
+    assert_true(TextTableAdd(&tStreamTable, NULL, "b"));
+    assert_true(TextTableAdd(&tStreamTable, NULL, "2"));
+    assert_true(TextTableStreamEnd(&tStreamTable));
+    assert_int_equal(tStreamTable.entries, 2);
+    assert_true(TextTableAdd(&tStreamTable, NULL, "a much longer name"));
+    assert_true(TextTableAdd(&tStreamTable, "\033[1m", "12345"));
+    assert_true(TextTableSet(&tStreamTable, 0, 1, NULL, "value\nin two rows"));
+    assert_true(TextTableAdd(&tExpected, NULL, "name"));
+    assert_true(TextTableAdd(&tExpected, NULL, "value\nin two rows"));
+    assert_true(TextTableAdd(&tExpected, NULL, "a much longer name"));
+    assert_true(TextTableAdd(&tExpected, "\033[1m", "12345"));
+    sCaptureLen = 0;
+    assert_true(TextTablePrint(&tExpected, PrintLineCapture, TABSTYLE_REGULAR_HEAD_ON, 1, 0));
+    size_t expectedLen = sCaptureLen;
+    memcpy(sExpectedBuf, sCaptureBuf, sCaptureLen);
+    sCaptureLen = 0;
+    assert_true(TextTablePrint(&tStreamTable, PrintLineCapture, TABSTYLE_REGULAR_HEAD_ON, 1, 0));
+    assert_int_equal(sCaptureLen, expectedLen);
+    assert_memory_equal(sCaptureBuf, sExpectedBuf, expectedLen);
+    TextTableFree(&tExpected);
+    TextTableFree(&tStreamTable);
+  }
+
+  // free without end
+  assert_true(TextTableInit(&tStreamTable));
+  assert_true(TextTableStreamBegin(&tStreamTable, &stream, PrintLine, TABSTYLE_COMACT, 0, 1, NULL, 0));
+  assert_true(TextTableAdd(&tStreamTable, NULL, "head"));
+  assert_true(TextTableAdd(&tStreamTable, NULL, "row"));
+  TextTableFree(&tStreamTable);
+  assert_null(tStreamTable.stream);
+  TextTableFree(&tTextTable);
+}
+
+/**
+ * @brief   Test that the cached layout follows new entries and border changes.
+ */
+void UTest_TextTablePrint_LayoutCache(void** state)
+{
+  (void)state;
+  static char sExpectedBuf[sizeof(sCaptureBuf)];
+  size_t expectedLen = 0;
+  TextTable_t tTextTable;
+  TextTable_t tFreshTable;
+  assert_true(TextTableInit(&tTextTable));
+  FillTable(&tTextTable);
+  assert_true(TextTablePrint(&tTextTable, PrintLine, TABSTYLE_SEPARATED_HEAD_ON, 0, 3));
+
+  // wider entries after the first print
+  assert_true(TextTableAdd(&tTextTable, NULL, "a much wider entry in column one"));
+  assert_true(TextTableAdd(&tTextTable, "\033[1;31m", "x"));
+  assert_true(TextTableAdd(&tTextTable, NULL, "y"));
+  tTextTable.charGridX = '~';
+  tTextTable.charConnectorXY = '*';
+  sCaptureLen = 0;
+  assert_true(TextTablePrint(&tTextTable, PrintLineCapture, TABSTYLE_SEPARATED_HEAD_ON, 2, 3));
+  memcpy(sExpectedBuf, sCaptureBuf, sCaptureLen);
+  expectedLen = sCaptureLen;
+
+  assert_true(TextTableInit(&tFreshTable));
+  FillTable(&tFreshTable);
+  assert_true(TextTableAdd(&tFreshTable, NULL, "a much wider entry in column one"));
+  assert_true(TextTableAdd(&tFreshTable, "\033[1;31m", "x"));
+  assert_true(TextTableAdd(&tFreshTable, NULL, "y"));
+  tFreshTable.charGridX = '~';
+  tFreshTable.charConnectorXY = '*';
+  sCaptureLen = 0;
+  assert_true(TextTablePrint(&tFreshTable, PrintLineCapture, TABSTYLE_SEPARATED_HEAD_ON, 2, 3));
+  assert_int_equal(sCaptureLen, expectedLen);
+  assert_memory_equal(sCaptureBuf, sExpectedBuf, expectedLen);
+
+  // other column count and back
+  assert_true(TextTablePrint(&tTextTable, PrintLine, TABSTYLE_SEPARATED_HEAD_ON, 2, 5));
+  sCaptureLen = 0;
+  assert_true(TextTablePrint(&tTextTable, PrintLineCapture, TABSTYLE_SEPARATED_HEAD_ON, 2, 3));
+  assert_int_equal(sCaptureLen, expectedLen);
+  assert_memory_equal(sCaptureBuf, sExpectedBuf, expectedLen);
+
+  TextTableFree(&tTextTable);
+  TextTableFree(&tFreshTable);
+}
+
+/**
+ * @brief   Test texts with several rows and with a `\0`, shorter and longer than one scan block,
+ *          each row is printed from the row index of the cell.
+ */
+void UTest_TextTablePrint_MultiLine(void** state)
+{
+  (void)state;
+  static const char sExpected[] =
+    "+------------------------------------------+\n"
+    "| head                                     |\n"
+    "+------------------------------------------+\n"
+    "| aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa |\n"
+    "| bbbbbbbbbbbbbbbb                         |\n"
+    "| cc                                       |\n"
+    "+------------------------------------------+\n"
+    "| x                                        |\n"
+    "+------------------------------------------+\n"
+    "| 0123456789012345678901234567890123456789 |\n"
+    "+------------------------------------------+\n"
+    "| a                                        |\n"
+    "|                                          |\n"
+    "| b                                        |\n"
+    "+------------------------------------------+\n";
+  TextTable_t tTextTable;
+  assert_true(TextTableInit(&tTextTable));
+  assert_true(TextTableInitColumns(&tTextTable, 1));
+  assert_true(TextTableAdd(&tTextTable, NULL, "head"));
+  assert_null(tTextTable.cells.rowStart);
+  assert_true(TextTableAdd(&tTextTable, NULL, "%s\nbbbbbbbbbbbbbbbb\ncc", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"));
+  assert_true(TextTableAdd(&tTextTable, NULL, "x%cy\nz", 0));
+  assert_true(TextTableAdd(&tTextTable, NULL, "0123456789012345678901234567890123456789%c\nhidden", 0));
+  assert_true(TextTableAdd(&tTextTable, NULL, "a\n\nb"));
+  assert_int_equal(tTextTable.cells.textRows[1], 3);
+  assert_int_equal(tTextTable.cells.rowMaxTextLen[1], 40);
+  assert_int_equal(tTextTable.cells.textRows[2], 1);
+  assert_int_equal(tTextTable.cells.textRows[3], 1);
+  assert_int_equal(tTextTable.cells.rowMaxTextLen[3], 40);
+  assert_null(tTextTable.cells.rowStart[0]);
+  assert_memory_equal(tTextTable.cells.rowStart[1], "\x00\x29\x3A\x3D", 4);
+  assert_memory_equal(tTextTable.cells.rowStart[3], "\x00\x29", 2);
+
+  sCaptureLen = 0;
+  assert_true(TextTablePrint(&tTextTable, PrintLineCapture, TABSTYLE_SEPARATED_HEAD_OFF, 0, 1));
+  assert_int_equal(sCaptureLen, strlen(sExpected));
+  assert_memory_equal(sCaptureBuf, sExpected, sCaptureLen);
+
+  // same result after changing the cells in place
+  assert_true(TextTableSet(&tTextTable, 1, 0, NULL, "x%cy\nz", 0));
+  assert_int_equal(tTextTable.cells.textRows[1], 1);
+  assert_true(TextTableSet(&tTextTable, 1, 0, NULL, "%s\nbbbbbbbbbbbbbbbb\ncc", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"));
+  sCaptureLen = 0;
+  assert_true(TextTablePrint(&tTextTable, PrintLineCapture, TABSTYLE_SEPARATED_HEAD_OFF, 0, 1));
+  assert_int_equal(sCaptureLen, strlen(sExpected));
+  assert_memory_equal(sCaptureBuf, sExpected, sCaptureLen);
+  TextTableFree(&tTextTable);
+}
+
+/**
+ * @brief   Add one row of the append tests, the cells of a row can be checked against each other.
+ */
+static void AddAppendRow(TextTable_t* table, size_t producer, size_t row)
+{
+  assert_true(TextTableAdd(table, (0 == (row % 5)) ? "\033[1m" : NULL, "p%zu", producer));
+  assert_true(TextTableAdd(table, NULL, "r%zu", row));
+  assert_true(TextTableAdd(table, NULL, (0 == (row % 3)) ? "%zu\n%zu" : "%zu", (producer * 1000) + row, row));
+}
+
+/**
+ * @brief   Check that each row of the append tests is complete and comes from one producer.
+ * @return  Number of rows
+ */
+static size_t CheckAppendRows(const TextTable_t* table)
+{
+  size_t rows = table->entries / 3;
+  for (size_t row = 0; row < rows; row++)
+  {
+    char expected[64];
+    size_t producer = 0;
+    size_t producerRow = 0;
+    assert_int_equal(sscanf(TextTableGetText(table, 3, row, 0, NULL), "p%zu", &producer), 1);
+    assert_int_equal(sscanf(TextTableGetText(table, 3, row, 1, NULL), "r%zu", &producerRow), 1);
+    snprintf(expected, sizeof(expected), (0 == (producerRow % 3)) ? "%zu\n%zu" : "%zu", (producer * 1000) + producerRow,
+             producerRow);
+    assert_string_equal(TextTableGetText(table, 3, row, 2, NULL), expected);
+  }
+  return rows;
+}
+
+/**
+ * @brief   Test @ref TextTableAppend() against a table with the rows added directly, with and without arena.
+ */
+void UTest_TextTableAppend(void** state)
+{
+  (void)state;
+  static char sExpectedBuf[sizeof(sCaptureBuf)];
+  for (size_t chunkSize = 0; chunkSize <= 256; chunkSize += 256)
+  {
+    TextTable_t tTextTable;
+    TextTable_t tExpected;
+    TextTable_t tRows;
+    assert_true((0 == chunkSize) ? TextTableInit(&tTextTable) : TextTableInitArena(&tTextTable, chunkSize));
+    assert_true((0 == chunkSize) ? TextTableInit(&tExpected) : TextTableInitArena(&tExpected, chunkSize));
+    assert_true((0 == chunkSize) ? TextTableInit(&tRows) : TextTableInitArena(&tRows, chunkSize));
+    assert_true(TextTableInitColumns(&tTextTable, 3));
+    assert_true(TextTableInitColumns(&tExpected, 3));
+    assert_true(TextTableInitColumns(&tRows, 3));
+    AddAppendRow(&tRows, 1, 1);
+    assert_false(TextTableAppend(NULL, &tRows));
+    assert_false(TextTableAppend(&tTextTable, NULL));
+    assert_false(TextTableAppend(&tTextTable, &tTextTable));
+    assert_true(TextTableAdd(&tRows, NULL, "incomplete"));
+    assert_false(TextTableAppend(&tTextTable, &tRows));
+    assert_int_equal(tRows.entries, 4);
+    assert_int_equal(tTextTable.entries, 0);
+    TextTableFree(&tRows);
+    assert_true((0 == chunkSize) ? TextTableInit(&tRows) : TextTableInitArena(&tRows, chunkSize));
+    assert_true(TextTableAppend(&tTextTable, &tRows));
+
+    // header and rows without row index first, the row index array is created by a later append
+    AddAppendRow(&tExpected, 0, 1);
+    AddAppendRow(&tRows, 0, 1);
+    assert_true(TextTableAppend(&tTextTable, &tRows));
+    assert_int_equal(tRows.entries, 0);
+    assert_null(tTextTable.cells.rowStart);
+    for (size_t row = 2; row < 20; row++)
+    {
+      AddAppendRow(&tExpected, row % 4, row);
+      AddAppendRow(&tRows, row % 4, row);
+      if (0 == (row % 4))
+      {
+        assert_true(TextTableAppend(&tTextTable, &tRows));
+      }
+    }
+    assert_true(TextTableAppend(&tTextTable, &tRows));
+    assert_int_equal(tTextTable.entries, tExpected.entries);
+    assert_int_equal(CheckAppendRows(&tTextTable), 19);
+
+    for (size_t style = TABSTYLE_REGULAR_HEAD_ON; style <= TABSTYLE_COMACT; style++)
+    {
+      sCaptureLen = 0;
+      assert_true(TextTablePrint(&tExpected, PrintLineCapture, (TabStyle_e)style, 1, 0));
+      size_t expectedLen = sCaptureLen;
+      memcpy(sExpectedBuf, sCaptureBuf, sCaptureLen);
+      sCaptureLen = 0;
+      assert_true(TextTablePrint(&tTextTable, PrintLineCapture, (TabStyle_e)style, 1, 0));
+      assert_int_equal(sCaptureLen, expectedLen);
+      assert_memory_equal(sCaptureBuf, sExpectedBuf, expectedLen);
+    }
+
+    // moved rows can be changed like added rows
+    assert_true(TextTableSet(&tTextTable, 3, 2, NULL, "a much longer text\nin two rows"));
+    assert_string_equal(TextTableGetText(&tTextTable, 3, 3, 2, NULL), "a much longer text\nin two rows");
+    TextTableFree(&tRows);
+    TextTableFree(&tExpected);
+    TextTableFree(&tTextTable);
+  }
+
+  // tables with and without arena cannot be mixed
+  TextTable_t tHeap;
+  TextTable_t tArena;
+  assert_true(TextTableInit(&tHeap));
+  assert_true(TextTableInitColumns(&tHeap, 3));
+  assert_true(TextTableInitArena(&tArena, 0));
+  AddAppendRow(&tArena, 0, 0);
+  assert_false(TextTableAppend(&tHeap, &tArena));
+  TextTableFree(&tArena);
+  TextTableFree(&tHeap);
+
+  // a failed append leaves the styles and cells of both tables unchanged
+  TextTable_t tStyles;
+  TextTable_t tRows;
+  assert_true(TextTableInit(&tStyles));
+  assert_true(TextTableInitColumns(&tStyles, 1));
+  assert_true(TextTableInit(&tRows));
+  for (size_t cell = 0; cell < (TEXT_TABLE_MAX_STYLES + 1); cell++)
+  {
+    char ansiSeq[16];
+    snprintf(ansiSeq, sizeof(ansiSeq), "\033[38;5;%zum", cell);
+    assert_true(TextTableAdd((cell < (TEXT_TABLE_MAX_STYLES - 1)) ? &tStyles : &tRows, ansiSeq, "c"));
+  }
+  assert_false(TextTableAppend(&tStyles, &tRows));
+  assert_int_equal(tStyles.styles.count, TEXT_TABLE_MAX_STYLES - 1);
+  assert_int_equal(tStyles.entries, TEXT_TABLE_MAX_STYLES - 1);
+  assert_int_equal(tRows.entries, 2);
+  TextTableFree(&tRows);
+  assert_true(TextTableInit(&tRows));
+  assert_true(TextTableAdd(&tRows, "\033[1m", "bold"));
+  assert_true(TextTableAppend(&tStyles, &tRows));
+  assert_int_equal(tStyles.styles.count, TEXT_TABLE_MAX_STYLES);
+  assert_int_equal(tStyles.entries, TEXT_TABLE_MAX_STYLES);
+  TextTableFree(&tRows);
+  TextTableFree(&tStyles);
+}
+
+/**
+ * @brief   Test the writer and reader functions of @ref TextTableSnapshot_t in one thread.
+ */
+void UTest_TextTableSnapshot(void** state)
+{
+  (void)state;
+  TextTableSnapshot_t snapshot;
+  assert_false(TextTableSnapshotInit(NULL, 2, 0));
+  assert_null(TextTableSnapshotBegin(NULL));
+  assert_false(TextTableSnapshotPublish(NULL));
+  assert_null(TextTableSnapshotAcquire(NULL));
+  assert_true(TextTableSnapshotInit(&snapshot, 2, 0));
+  assert_false(TextTableSnapshotPublish(&snapshot));
+  assert_null(TextTableSnapshotAcquire(&snapshot));
+
+  // first version
+  TextTable_t* pBack = TextTableSnapshotBegin(&snapshot);
+  assert_non_null(pBack);
+  assert_true(TextTableAdd(pBack, NULL, "name"));
+  assert_true(TextTableAdd(pBack, NULL, "value"));
+  assert_true(TextTableAdd(pBack, NULL, "first"));
+  assert_true(TextTableAdd(pBack, NULL, "1\n1"));
+  assert_null(TextTableSnapshotAcquire(&snapshot));
+  assert_true(TextTableSnapshotPublish(&snapshot));
+  assert_false(TextTableSnapshotPublish(&snapshot));
+  const TextTable_t* pFirst = TextTableSnapshotAcquire(&snapshot);
+  assert_ptr_equal(pFirst, pBack);
+
+  // second version while the first is still printed, a third one must not reuse the printed table
+  pBack = TextTableSnapshotBegin(&snapshot);
+  assert_ptr_not_equal(pBack, pFirst);
+  assert_true(TextTableAdd(pBack, NULL, "name"));
+  assert_true(TextTableAdd(pBack, NULL, "value"));
+  assert_true(TextTableSnapshotPublish(&snapshot));
+  assert_string_equal(TextTableGetText(pFirst, 2, 1, 0, NULL), "first");
+  const TextTable_t* pSecond = TextTableSnapshotAcquire(&snapshot);
+  assert_ptr_equal(pSecond, pBack);
+  pBack = TextTableSnapshotBegin(&snapshot);
+  assert_ptr_not_equal(pBack, pFirst);
+  assert_ptr_not_equal(pBack, pSecond);
+  assert_true(TextTableAdd(pBack, NULL, "name"));
+  assert_true(TextTableAdd(pBack, NULL, "value"));
+  assert_true(TextTableAdd(pBack, NULL, "third"));
+  assert_true(TextTableAdd(pBack, NULL, "3"));
+  assert_true(TextTableSnapshotPublish(&snapshot));
+
+  // both unpublished tables are printed: no back table, the writer does not wait
+  assert_null(TextTableSnapshotBegin(&snapshot));
+  assert_false(TextTableSnapshotPublish(&snapshot));
+  TextTableSnapshotRelease(&snapshot, pSecond);
+
+  // the first table is reused as soon as it is released, its memory is kept
+  TextTableSnapshotRelease(&snapshot, pFirst);
+  size_t allocations = gTestAllocations;
+  pBack = TextTableSnapshotBegin(&snapshot);
+  assert_int_equal(pBack->entries, 0);
+  assert_true(TextTableAdd(pBack, NULL, "%s", "name"));
+  assert_true(TextTableAdd(pBack, NULL, "%s", "value"));
+  assert_true(TextTableSnapshotPublish(&snapshot));
+  assert_int_equal(gTestAllocations, allocations + 2);
+
+  const TextTable_t* pTable = TextTableSnapshotAcquire(&snapshot);
+  sCaptureLen = 0;
+  assert_true(TextTablePrint(pTable, PrintLineCapture, TABSTYLE_REGULAR_HEAD_ON, 0, 0));
+  sCaptureBuf[sCaptureLen] = 0x00;
+  assert_string_equal(sCaptureBuf,
+                      "+======+=======+\n"
+                      "| name | value |\n"
+                      "+======+=======+\n"
+                      "+------+-------+\n");
+  TextTableSnapshotRelease(&snapshot, pTable);
+  TextTableSnapshotFree(&snapshot);
+}
+
+#ifndef __STDC_NO_THREADS__
+#define SNAPSHOT_READERS  4     ///< Number of threads printing the snapshot
+#define SNAPSHOT_VERSIONS 300   ///< Number of tables published by the writer
+
+/**
+ * @brief   State of one reader of @ref UTest_TextTableSnapshot_Concurrent()
+ */
+typedef struct
+{
+  TextTableSnapshot_t* snapshot;  ///< The shared snapshot
+  atomic_bool* done;              ///< Set by the writer after the last version
+  char buf[4096];                 ///< Output of one print
+  size_t prints;                  ///< Number of prints
+  size_t mismatches;              ///< Number of prints with mixed versions or an older version than before
+}T_SnapshotReader;
+
+/**
+ * @brief   Reader of @ref UTest_TextTableSnapshot_Concurrent(): prints the published table until the writer is done
+ *          (at least once), all cells of one table must show the same version and the versions must not go back.
+ */
+static int SnapshotReader(void* arg)
+{
+  T_SnapshotReader* pReader = (T_SnapshotReader*)arg;
+  TextTableRenderCtx_t ctx;
+  TextTableRenderCtxInit(&ctx);
+  size_t lastVersion = 0;
+  while (!atomic_load(pReader->done) || (0 == pReader->prints))
+  {
+    const TextTable_t* table = TextTableSnapshotAcquire(pReader->snapshot);
+    if (NULL == table)
+    {
+      continue;
+    }
+    size_t len = TextTableRenderCtx(table, &ctx, TABSTYLE_SEPARATED_HEAD_ON, 0, 0, pReader->buf,
+                                    sizeof(pReader->buf), NULL);
+    size_t version = 0;
+    sscanf(TextTableGetText(table, 2, 0, 1, NULL), "v%zu", &version);
+    TextTableSnapshotRelease(pReader->snapshot, table);
+
+    // each line with cells shows the version
+    char expected[16];
+    char line[sizeof(pReader->buf)];
+    snprintf(expected, sizeof(expected), "| v%zu ", version);
+    size_t lines = 0;
+    for (size_t pos = 0; pos < len;)
+    {
+      size_t lineLen = (size_t)((char*)memchr(&pReader->buf[pos], '\n', len - pos) - &pReader->buf[pos]);
+      memcpy(line, &pReader->buf[pos], lineLen);
+      line[lineLen] = 0x00;
+      if ('|' == line[0])
+      {
+        if (NULL == strstr(line, expected))
+        {
+          pReader->mismatches++;
+        }
+        lines++;
+      }
+      pos += lineLen + 1;
+    }
+    if ((0 == len) || (version < lastVersion) || (lines != ((version % 7) + 2)))
+    {
+      pReader->mismatches++;
+    }
+    lastVersion = version;
+    pReader->prints++;
+  }
+  TextTableRenderCtxFree(&ctx);
+  return 0;
+}
+
+/**
+ * @brief   Test that readers always print a complete published table while the writer publishes new versions.
+ */
+void UTest_TextTableSnapshot_Concurrent(void** state)
+{
+  (void)state;
+  static T_SnapshotReader sReaders[SNAPSHOT_READERS];
+  static atomic_bool sDone;
+  thrd_t threads[SNAPSHOT_READERS];
+  TextTableSnapshot_t snapshot;
+  assert_true(TextTableSnapshotInit(&snapshot, 2, 1024));
+  atomic_store(&sDone, false);
+  for (size_t i = 0; i < SNAPSHOT_READERS; i++)
+  {
+    sReaders[i].snapshot = &snapshot;
+    sReaders[i].done = &sDone;
+    sReaders[i].prints = 0;
+    sReaders[i].mismatches = 0;
+    assert_int_equal(thrd_create(&threads[i], SnapshotReader, &sReaders[i]), thrd_success);
+  }
+  for (size_t version = 1; version <= SNAPSHOT_VERSIONS; version++)
+  {
+    TextTable_t* pBack = TextTableSnapshotBegin(&snapshot);
+    while (NULL == pBack)
+    {
+      thrd_yield(); // all unpublished tables are still printed, try again
+      pBack = TextTableSnapshotBegin(&snapshot);
+    }
+    assert_true(TextTableAdd(pBack, NULL, "version"));
+    assert_true(TextTableAdd(pBack, NULL, "v%zu ", version));
+    for (size_t row = 0; row <= (version % 7); row++)
+    {
+      assert_true(TextTableAdd(pBack, NULL, "row %zu", row));
+      assert_true(TextTableAdd(pBack, NULL, "v%zu %s", version, (0 == (row % 2)) ? "even" : "odd"));
+    }
+    assert_true(TextTableSnapshotPublish(&snapshot));
+    if (0 == (version % 32))
+    {
+      thrd_yield();
+    }
+  }
+  atomic_store(&sDone, true);
+  for (size_t i = 0; i < SNAPSHOT_READERS; i++)
+  {
+    assert_int_equal(thrd_join(threads[i], NULL), thrd_success);
+    assert_int_not_equal(sReaders[i].prints, 0);
+    assert_int_equal(sReaders[i].mismatches, 0);
+  }
+  TextTableSnapshotFree(&snapshot);
+}
+
+#define APPEND_THREADS  8     ///< Number of threads appending to one table at once
+#define APPEND_BATCHES  50    ///< Number of appends per thread
+#define APPEND_ROWS     4     ///< Number of rows per append
+
+/**
+ * @brief   State of one thread of @ref UTest_TextTableAppend_Concurrent()
+ */
+typedef struct
+{
+  TextTable_t* table;   ///< The shared table
+  size_t producer;      ///< Number of the thread, written to the first column
+}T_AppendThread;
+
+/**
+ * @brief   Thread of @ref UTest_TextTableAppend_Concurrent(): fills its own rows and appends them in batches.
+ */
+static int AppendThread(void* arg)
+{
+  TextTable_t* table = ((T_AppendThread*)arg)->table;
+  size_t producer = ((T_AppendThread*)arg)->producer;
+  size_t failures = 0;
+  TextTable_t tRows;
+  TextTableInit(&tRows);
+  for (size_t batch = 0; batch < APPEND_BATCHES; batch++)
+  {
+    for (size_t row = 0; row < APPEND_ROWS; row++)
+    {
+      size_t producerRow = (batch * APPEND_ROWS) + row;
+      TextTableAdd(&tRows, (0 == (producerRow % 5)) ? "\033[1m" : NULL, "p%zu", producer);
+      TextTableAdd(&tRows, NULL, "r%zu", producerRow);
+      TextTableAdd(&tRows, NULL, (0 == (producerRow % 3)) ? "%zu\n%zu" : "%zu", (producer * 1000) + producerRow,
+                   producerRow);
+    }
+    if (!TextTableAppend(table, &tRows))
+    {
+      failures++;
+    }
+  }
+  TextTableFree(&tRows);
+  return (int)failures;
+}
+
+/**
+ * @brief   Test that several threads can append rows to one table at once: no row is lost or mixed with another one
+ *          and the column widths are the same as with all rows added by one thread.
+ */
+void UTest_TextTableAppend_Concurrent(void** state)
+{
+  (void)state;
+  static char sExpectedBuf[sizeof(sCaptureBuf)];
+  static T_AppendThread sThreads[APPEND_THREADS];
+  thrd_t threads[APPEND_THREADS];
+  TextTable_t tTextTable;
+  TextTable_t tExpected;
+  assert_true(TextTableInit(&tTextTable));
+  assert_true(TextTableInitColumns(&tTextTable, 3));
+  assert_true(TextTableInit(&tExpected));
+  assert_true(TextTableInitColumns(&tExpected, 3));
+  for (size_t i = 0; i < APPEND_THREADS; i++)
+  {
+    sThreads[i].table = &tTextTable;
+    sThreads[i].producer = i;
+    assert_int_equal(thrd_create(&threads[i], AppendThread, &sThreads[i]), thrd_success);
+  }
+  for (size_t i = 0; i < APPEND_THREADS; i++)
+  {
+    int failures = -1;
+    assert_int_equal(thrd_join(threads[i], &failures), thrd_success);
+    assert_int_equal(failures, 0);
+  }
+  assert_int_equal(CheckAppendRows(&tTextTable), APPEND_THREADS * APPEND_BATCHES * APPEND_ROWS);
+
+  // every row of every producer is there exactly once
+  static bool sSeen[APPEND_THREADS][APPEND_BATCHES * APPEND_ROWS];
+  memset(sSeen, 0, sizeof(sSeen));
+  for (size_t row = 0; row < (APPEND_THREADS * APPEND_BATCHES * APPEND_ROWS); row++)
+  {
+    size_t producer = 0;
+    size_t producerRow = 0;
+    sscanf(TextTableGetText(&tTextTable, 3, row, 0, NULL), "p%zu", &producer);
+    sscanf(TextTableGetText(&tTextTable, 3, row, 1, NULL), "r%zu", &producerRow);
+    assert_true(producer < APPEND_THREADS);
+    assert_false(sSeen[producer][producerRow]);
+    sSeen[producer][producerRow] = true;
+  }
+
+  // same column widths, the grid line is the first line of the output
+  for (size_t producer = 0; producer < APPEND_THREADS; producer++)
+  {
+    for (size_t row = 0; row < (APPEND_BATCHES * APPEND_ROWS); row++)
+    {
+      AddAppendRow(&tExpected, producer, row);
+    }
+  }
+  TextTableRenderCtx_t ctx;
+  assert_true(TextTableRenderCtxInit(&ctx));
+  sCaptureLen = 0;
+  assert_true(TextTablePrintRange(&tExpected, &ctx, PrintLineCapture, TABSTYLE_SEPARATED_HEAD_ON, 0, 3, 0, 1, false));
+  size_t expectedLen = sCaptureLen;
+  memcpy(sExpectedBuf, sCaptureBuf, sCaptureLen);
+  sCaptureLen = 0;
+  assert_true(TextTablePrintRange(&tTextTable, &ctx, PrintLineCapture, TABSTYLE_SEPARATED_HEAD_ON, 0, 3, 0, 1, false));
+  assert_int_equal(sCaptureLen, expectedLen);
+  assert_memory_equal(sCaptureBuf, sExpectedBuf, expectedLen);
+  TextTableRenderCtxFree(&ctx);
+  TextTableFree(&tExpected);
+  TextTableFree(&tTextTable);
+}
+
+#define STRESS_THREADS  8     ///< Number of threads printing one table at once
+#define STRESS_LOOPS    500   ///< Number of prints per thread
+#define STRESS_VARIANTS 4     ///< Number of different prints, each changes the cached layout of the table
+
+/**
+ * @brief   State of one thread of @ref UTest_TextTablePrint_Concurrent()
+ */
+typedef struct
+{
+  const TextTable_t* table;       ///< The shared table
+  TextTableRenderCtx_t ctx;       ///< Render context of the thread
+  char buf[2048];                 ///< Output of one print
+  size_t mismatches;              ///< Number of prints that differ from the expected output
+}T_StressThread;
+
+static const size_t sStressPosX[STRESS_VARIANTS] = {0, 3, 0, 5};            ///< Right shift of each print variant
+static const size_t sStressColumns[STRESS_VARIANTS] = {3, 3, 4, 2};         ///< Columns of each print variant
+static char sStressExpected[STRESS_VARIANTS][2048];                         ///< Expected output of each print variant
+static size_t sStressExpectedLen[STRESS_VARIANTS];                          ///< Expected length of each print variant
+
+/**
+ * @brief   Thread of @ref UTest_TextTablePrint_Concurrent(): prints all variants in turn and compares the output.
+ */
+static int StressThread(void* arg)
+{
+  T_StressThread* pThread = (T_StressThread*)arg;
+  for (size_t loop = 0; loop < STRESS_LOOPS; loop++)
+  {
+    size_t variant = loop % STRESS_VARIANTS;
+    size_t len = TextTableRenderCtx(pThread->table, &pThread->ctx, TABSTYLE_SEPARATED_HEAD_ON, sStressPosX[variant],
+                                    sStressColumns[variant], pThread->buf, sizeof(pThread->buf), NULL);
+    if ((len != sStressExpectedLen[variant]) || (0 != memcmp(pThread->buf, sStressExpected[variant], len)))
+    {
+      pThread->mismatches++;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief   Test that several threads can print one table at once: each print gives byte identical output,
+ *          although the prints change the cached layout of the table all the time.
+ *          The render contexts are large enough before the threads start, so the threads do not allocate.
+ */
+void UTest_TextTablePrint_Concurrent(void** state)
+{
+  (void)state;
+  static T_StressThread sThreads[STRESS_THREADS];
+  thrd_t threads[STRESS_THREADS];
+  TextTable_t tTextTable;
+  assert_true(TextTableInit(&tTextTable));
+  FillTable(&tTextTable);
+  for (size_t variant = 0; variant < STRESS_VARIANTS; variant++)
+  {
+    sStressExpectedLen[variant] = TextTableRender(&tTextTable, TABSTYLE_SEPARATED_HEAD_ON, sStressPosX[variant],
+                                                  sStressColumns[variant], sStressExpected[variant],
+                                                  sizeof(sStressExpected[variant]), NULL);
+    assert_int_not_equal(sStressExpectedLen[variant], 0);
+  }
+  for (size_t i = 0; i < STRESS_THREADS; i++)
+  {
+    sThreads[i].table = &tTextTable;
+    sThreads[i].mismatches = 0;
+    assert_true(TextTableRenderCtxInit(&sThreads[i].ctx));
+    for (size_t variant = 0; variant < STRESS_VARIANTS; variant++)
+    {
+      assert_int_equal(TextTableRenderCtx(&tTextTable, &sThreads[i].ctx, TABSTYLE_SEPARATED_HEAD_ON,
+                                          sStressPosX[variant], sStressColumns[variant], sThreads[i].buf,
+                                          sizeof(sThreads[i].buf), NULL), sStressExpectedLen[variant]);
+    }
+  }
+
+  size_t allocations = gTestAllocations;
+  for (size_t i = 0; i < STRESS_THREADS; i++)
+  {
+    assert_int_equal(thrd_create(&threads[i], StressThread, &sThreads[i]), thrd_success);
+  }
+  for (size_t i = 0; i < STRESS_THREADS; i++)
+  {
+    assert_int_equal(thrd_join(threads[i], NULL), thrd_success);
+  }
+  assert_int_equal(gTestAllocations, allocations);
+  for (size_t i = 0; i < STRESS_THREADS; i++)
+  {
+    assert_int_equal(sThreads[i].mismatches, 0);
+    TextTableRenderCtxFree(&sThreads[i].ctx);
+  }
+  TextTableFree(&tTextTable);
+}
+#endif
+
+/**
+ * @brief   Test @ref TextTablePrintParallel() against @ref TextTablePrint() for several threads and block sizes.
+ */
+void UTest_TextTablePrintParallel(void** state)
+{
+  (void)state;
+  static char sExpectedBuf[sizeof(sCaptureBuf)];
+  static const size_t sThreads[] = {0, 1, 2, 4};
+  static const size_t sBlockRows[] = {0, 1, 2, 7};
+  T_LinesCapture capture;
+  TextTable_t tTextTable;
+  assert_true(TextTableInit(&tTextTable));
+  FillPage(&tTextTable, 1, 40);
+  assert_false(TextTablePrintParallel(NULL, PrintLinesCapture, &capture, TABSTYLE_REGULAR_HEAD_ON, 0, 2, 2, 0));
+  assert_false(TextTablePrintParallel(&tTextTable, NULL, &capture, TABSTYLE_REGULAR_HEAD_ON, 0, 2, 2, 1));
+  assert_false(TextTablePrintParallel(&tTextTable, PrintLinesCapture, &capture, TABSTYLE_REGULAR_HEAD_ON, 0, 3, 2, 1));
+
+  for (size_t style = TABSTYLE_REGULAR_HEAD_ON; style <= TABSTYLE_COMACT; style++)
+  {
+    sCaptureLen = 0;
+    assert_true(TextTablePrint(&tTextTable, PrintLineCapture, (TabStyle_e)style, 1, 2));
+    size_t expectedLen = sCaptureLen;
+    memcpy(sExpectedBuf, sCaptureBuf, sCaptureLen);
+    size_t expectedLines = 0;
+    for (size_t i = 0; i < expectedLen; i++)
+    {
+      expectedLines += ('\n' == sExpectedBuf[i]) ? 1 : 0;
+    }
+    for (size_t i = 0; i < (sizeof(sThreads) / sizeof(sThreads[0])); i++)
+    {
+      for (size_t j = 0; j < (sizeof(sBlockRows) / sizeof(sBlockRows[0])); j++)
+      {
+        memset(&capture, 0, sizeof(capture));
+        sCaptureLen = 0;
+        assert_true(TextTablePrintParallel(&tTextTable, PrintLinesCapture, &capture, (TabStyle_e)style, 1, 2,
+                                           sThreads[i], sBlockRows[j]));
+        assert_int_equal(capture.errors, 0);
+        assert_int_equal(capture.lines, expectedLines);
+        assert_true(capture.calls <= expectedLines);
+        assert_int_equal(sCaptureLen, expectedLen);
+        assert_memory_equal(sCaptureBuf, sExpectedBuf, expectedLen);
+      }
+    }
+  }
+  TextTableFree(&tTextTable);
+}
+
+/**
+ * @brief   Test that printing with a render context does not allocate memory once the context is large enough.
+ */
+void UTest_TextTablePrintCtx_NoAllocation(void** state)
+{
+  (void)state;
+  static char sRenderBuf[sizeof(sCaptureBuf)];
+  TextTableRenderCtx_t ctx;
+  TextTable_t tTextTable;
+  TextTable_t tSmallTable;
+  assert_false(TextTableRenderCtxInit(NULL));
+  assert_true(TextTableRenderCtxInit(&ctx));
+  assert_true(TextTableInit(&tTextTable));
+  assert_true(TextTableInit(&tSmallTable));
+  FillTable(&tTextTable);
+  assert_true(TextTableAdd(&tSmallTable, NULL, "small"));
+  assert_false(TextTablePrintCtx(&tTextTable, NULL, PrintLine, TABSTYLE_REGULAR_HEAD_ON, 0, 3));
+  assert_false(TextTablePrintCtx(&tTextTable, &ctx, NULL, TABSTYLE_REGULAR_HEAD_ON, 0, 3));
+
+  // first print grows the context and creates the layout of the tables
+  size_t allocations = gTestAllocations;
+  assert_true(TextTablePrintCtx(&tTextTable, &ctx, PrintLine, TABSTYLE_REGULAR_HEAD_ON, 0, 3));
+  assert_true(gTestAllocations > allocations);
+  assert_true(TextTablePrintCtx(&tTextTable, &ctx, PrintLine, TABSTYLE_REGULAR_HEAD_ON, 0, 1));
+  assert_true(TextTablePrintCtx(&tSmallTable, &ctx, PrintLine, TABSTYLE_REGULAR_HEAD_ON, 0, 1));
+
+  // steady state
+  allocations = gTestAllocations;
+  for (size_t style = TABSTYLE_REGULAR_HEAD_ON; style <= TABSTYLE_COMACT; style++)
+  {
+    assert_true(TextTablePrintCtx(&tTextTable, &ctx, PrintLine, (TabStyle_e)style, 0, 3));
+    assert_true(TextTablePrintCtx(&tTextTable, &ctx, PrintLine, (TabStyle_e)style, 0, 1));
+    assert_true(TextTablePrintCtx(&tSmallTable, &ctx, PrintLine, (TabStyle_e)style, 0, 1));
+    assert_true(TextTableRenderCtx(&tTextTable, &ctx, (TabStyle_e)style, 0, 3, sRenderBuf, sizeof(sRenderBuf), NULL) > 0);
+  }
+  assert_int_equal(gTestAllocations, allocations);
+
+  // same output as without context
+  sCaptureLen = 0;
+  assert_true(TextTablePrint(&tTextTable, PrintLineCapture, TABSTYLE_SEPARATED_HEAD_ON, 2, 3));
+  assert_int_equal(TextTableRenderCtx(&tTextTable, &ctx, TABSTYLE_SEPARATED_HEAD_ON, 2, 3, sRenderBuf, sizeof(sRenderBuf), NULL), sCaptureLen);
+  assert_memory_equal(sRenderBuf, sCaptureBuf, sCaptureLen);
+
+  TextTableRenderCtxFree(&ctx);
+  assert_null(ctx.lineBuf);
+  TextTableRenderCtxFree(NULL);
+  TextTableFree(&tTextTable);
+  TextTableFree(&tSmallTable);
+}
+
 /**
  * @brief    Run unit test with cmocka
  */
@@ -283,11 +2590,25 @@ int main(int argc, char* argv[])
   const struct CMUnitTest tests[] = {
     cmocka_unit_test_setup_teardown(UTest_TextTableInit_Fail, TestSetup, TestTeardown),
     cmocka_unit_test_setup_teardown(UTest_TextTableInit_Success, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableInitArena_Fail, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableInitArena_Chunks, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableInitColumns, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableSet, TestSetup, TestTeardown),
     cmocka_unit_test_setup_teardown(UTest_TextTableFree_NULL, TestSetup, TestTeardown),
     cmocka_unit_test_setup_teardown(UTest_TextTableAdd_TableNULL, TestSetup, TestTeardown),
     cmocka_unit_test_setup_teardown(UTest_TextTableAdd_ansiSeqNULL, TestSetup, TestTeardown),
     cmocka_unit_test_setup_teardown(UTest_TextTableAdd_ansiSeqTooLong, TestSetup, TestTeardown),
     cmocka_unit_test_setup_teardown(UTest_TextTableAdd_formatNULL, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableAdd_Truncated, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableAddInt, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableAddDouble, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableAddStr, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableStyles, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableAnsiMinimal, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableRowBuffer, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableAnsiStrip, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableUtf8, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableAddRef, TestSetup, TestTeardown),
     cmocka_unit_test_setup_teardown(UTest_TextTablePrint_ColumnError, TestSetup, TestTeardown),
     cmocka_unit_test_setup_teardown(UTest_TextTablePrint_TableNull, TestSetup, TestTeardown),
     cmocka_unit_test_setup_teardown(UTest_TextTablePrint_CallbackNull, TestSetup, TestTeardown),
@@ -295,6 +2616,24 @@ int main(int argc, char* argv[])
     cmocka_unit_test_setup_teardown(UTest_TextTablePrint_columns0, TestSetup, TestTeardown),
     cmocka_unit_test_setup_teardown(UTest_TextTablePrint_zeroEntries, TestSetup, TestTeardown),
     cmocka_unit_test_setup_teardown(UTest_TextTablePrint_SequenceOK, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTablePrint_Styles, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableGetText, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableRender_SameAsPrint, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableRender_Fail, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTablePrintCtx_NoAllocation, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTablePrintRange, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableStream, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTablePrint_LayoutCache, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTablePrint_MultiLine, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTablePrintBatch, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableAppend, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableSnapshot, TestSetup, TestTeardown),
+#ifndef __STDC_NO_THREADS__
+    cmocka_unit_test_setup_teardown(UTest_TextTableSnapshot_Concurrent, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTableAppend_Concurrent, TestSetup, TestTeardown),
+    cmocka_unit_test_setup_teardown(UTest_TextTablePrint_Concurrent, TestSetup, TestTeardown),
+#endif
+    cmocka_unit_test_setup_teardown(UTest_TextTablePrintParallel, TestSetup, TestTeardown),
   };
   return cmocka_run_group_tests(tests, GroupSetup, GroupTeardown);
 }
@@ -9,8 +9,26 @@
 #ifndef _TEXTTABLE_TEST_H_
 #define _TEXTTABLE_TEST_H_
 
+#include <stddef.h>
 #include <setjmp.h>
 #include <cmocka.h>
 
+extern size_t gTestAllocations;   ///< Number of heap allocations done by the implementation
+
+void* TestMalloc(size_t size, const char* file, int line);
+void* TestCalloc(size_t count, size_t size, const char* file, int line);
+void* TestRealloc(void* ptr, size_t size, const char* file, int line);
+void TestFree(void* ptr, const char* file, int line);
+
+// count the heap allocations of the implementation, the memory is still checked by cmocka
+#undef malloc
+#define malloc(size) TestMalloc(size, __FILE__, __LINE__)
+#undef realloc
+#define realloc(ptr, size) TestRealloc(ptr, size, __FILE__, __LINE__)
+#undef calloc
+#define calloc(count, size) TestCalloc(count, size, __FILE__, __LINE__)
+#undef free
+#define free(ptr) TestFree(ptr, __FILE__, __LINE__)
+
 #endif // _TEXTTABLE_TEST_H_
 